@@ -28,6 +28,12 @@
 /** @brief Shutdown/Habilitación driver pierna W (GPIOA, PIN_6). */
 #define GPIO_W_SD           GPIO_PIN_6
 
+/** @brief Entrada analógica: amplificador del shunt del bus de continua (GPIOA, PIN_0, ADC12_IN0). Ver SVM_CORRIENTE_SHUNT. */
+#define GPIO_SHUNT          GPIO_PIN_0
+/** @brief Entrada analógica: divisor de la tensión del bus de continua (GPIOA, PIN_7, ADC12_IN7). Ver SVM_VBUS_FUENTE.
+  *        Es TIM1_CH1N con remapeo parcial: no se puede usar con SVM_TIM1_COMPLEMENTARIAS. */
+#define GPIO_VBUS           GPIO_PIN_7
+
 /** @brief Entrada digital: Termo–switch (GPIOA, PIN_11). */
 #define GPIO_TERMO_SWITCH   GPIO_PIN_11
 /** @brief Entrada digital: Botón de parada (GPIOA, PIN_12). */
@@ -45,6 +51,30 @@
 #define GPIO_LED_ERROR      GPIO_PIN_2
 /** @} */
 
+/** \defgroup RAM_FUNC Camino crítico en SRAM
+  * @brief Ubicación en SRAM de las interrupciones de SVM y sus tablas.
+  * @details A 72 MHz la flash tiene 2 wait states y el prefetch no cubre los saltos. Lo marcado con @ref RAM_FUNC /
+  *          @ref RAM_CONST va a las secciones .RamFunc*, que el linker script de STM32CubeIDE ubica dentro de .data
+  *          (VMA en SRAM, LMA en flash) y el Reset_Handler copia junto con .data. Se ejecuta sin wait states.
+  * @{
+  */
+
+/** @brief 1: camino crítico en SRAM. 0: todo en flash (para comparar tiempos de ISR entre ambas versiones). */
+#ifndef EJECUTAR_EN_RAM
+#define EJECUTAR_EN_RAM     1
+#endif
+
+#if EJECUTAR_EN_RAM
+/** @brief Función copiada a SRAM en el arranque. */
+#define RAM_FUNC            __attribute__((section(".RamFunc")))
+/** @brief Tabla const copiada a SRAM en el arranque (de solo lectura para el programa). */
+#define RAM_CONST           __attribute__((section(".RamFunc.const")))
+#else
+#define RAM_FUNC
+#define RAM_CONST
+#endif
+/** @} */
+
 /**
   * @fn void Error_Handler(void)
   * @brief Manejador global de errores fatales.
@@ -53,4 +83,11 @@
   */
 void Error_Handler(void);
 
+/**
+  * @fn void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim)
+  * @brief Configura los pines de salida de los canales de un timer (TIM1 con @ref SVM_SALIDA_TIM1).
+  * @details Implementado en stm32f1xx_hal_msp.c.
+  */
+void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim);
+
 #endif /* __MAIN_H */
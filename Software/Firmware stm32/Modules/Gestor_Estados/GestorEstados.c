@@ -157,6 +157,50 @@ SystemActionResponse GestorEstados_Action(SystemAction sysAct, int value) {
                 retVal = ACTION_RESP_MOVING;
             }
             break;
+        case ACTION_SET_FREC_SWITCH:
+            if(currentState == STATE_IDLE) {
+                switch( GestorSVM_SetFrecuenciaSwitching(value)) {
+                    case 0:
+                        retVal = ACTION_RESP_OK;
+                        break;
+                    case -1:
+                        retVal = ACTION_RESP_OUT_RANGE;
+                        break;
+                    case -2:
+                        retVal = ACTION_RESP_MOVING;
+                        break;
+                    default:
+                        retVal = ACTION_RESP_ERR;
+                        break;
+                }
+            } else {
+                retVal = ACTION_RESP_MOVING;
+            }
+            break;
+        case ACTION_SET_MODULADOR:
+            if(currentState == STATE_IDLE || currentState == STATE_RUNNING || currentState == STATE_VEL_CHANGE) {
+                if(GestorSVM_SetModulador(value) == 0) {
+                    retVal = ACTION_RESP_OK;
+                } else {
+                    retVal = ACTION_RESP_OUT_RANGE;
+                }
+            } else {
+                retVal = ACTION_RESP_ERR;
+            }
+            break;
+        case ACTION_SET_VBUS:
+            switch( GestorSVM_SetTensionBus(value) ) {
+                case 0:
+                    retVal = ACTION_RESP_OK;
+                    break;
+                case -1:
+                    retVal = ACTION_RESP_OUT_RANGE;
+                    break;
+                default:
+                    retVal = ACTION_RESP_ERR;
+                    break;
+            }
+            break;
         // case ACTION_GET_FREC:            
         // case ACTION_GET_ACEL:            
         // case ACTION_GET_DESACEL:            
@@ -118,7 +118,7 @@ typedef enum {
     /**
      * @brief Fijar frecuencia de régimen.
      * @details Permitido en @ref STATE_IDLE, @ref STATE_RUNNING o
-     * @ref STATE_VEL_CHANGE. Llama a `GestorSVM_SetFrec(value)`:
+     * @ref STATE_VEL_CHANGE. Llama a `GestorSVM_SetFrec(value)`, value en centésimas de Hz:
      * - 0 o -2 → @ref ACTION_RESP_OK (permanece en el estado actual)
      * - 1      → pasa a @ref STATE_VEL_CHANGE y @ref ACTION_RESP_OK
      * - -1     → @ref ACTION_RESP_OUT_RANGE
@@ -199,6 +199,37 @@ typedef enum {
      * @ref ACTION_RESP_NOT_MOVING; en otro estado → @ref ACTION_RESP_MOVING.
      */
     ACTION_IS_MOTOR_STOP,
+
+    /**
+     * @brief Configurar frecuencia de switching.
+     * @details Permitido solo en @ref STATE_IDLE. Llama a `GestorSVM_SetFrecuenciaSwitching(value)`:
+     * - 0  → @ref ACTION_RESP_OK
+     * - -1 → @ref ACTION_RESP_OUT_RANGE
+     * - -2 → @ref ACTION_RESP_MOVING
+     * - otro → @ref ACTION_RESP_ERR
+     * Si no está en IDLE → @ref ACTION_RESP_MOVING.
+     */
+    ACTION_SET_FREC_SWITCH,
+
+    /**
+     * @brief Seleccionar modulador (SVPWM, SPWM o THIPWM).
+     * @details Permitido en @ref STATE_IDLE, @ref STATE_RUNNING o @ref STATE_VEL_CHANGE: el cambio se toma en la
+     * próxima muestra. Llama a `GestorSVM_SetModulador(value)`:
+     * - 0  → @ref ACTION_RESP_OK
+     * - -1 → @ref ACTION_RESP_OUT_RANGE
+     * En otros estados → @ref ACTION_RESP_ERR.
+     */
+    ACTION_SET_MODULADOR,
+
+    /**
+     * @brief Cargar la tensión del bus medida por el ESP32 [V].
+     * @details Permitido en cualquier estado: es una medición, no una configuración. Llama a
+     * `GestorSVM_SetTensionBus(value)`:
+     * - 0  → @ref ACTION_RESP_OK
+     * - -1 → @ref ACTION_RESP_OUT_RANGE
+     * - otro (el STM32 no compensa con la tensión del ESP32) → @ref ACTION_RESP_ERR
+     */
+    ACTION_SET_VBUS,
 } SystemAction;
 
 /**
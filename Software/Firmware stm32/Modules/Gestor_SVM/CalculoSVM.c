@@ -0,0 +1,194 @@
+/**
+ * @file CalculoSVM.c
+ * @brief Implementación del núcleo de cálculo SVM en punto fijo.
+ * @details
+ *   Reemplaza la regresión lineal en float que usaba el gestor SVM. En el STM32F103
+ *   (sin FPU) cada operación float se emula por software; acá el cálculo por muestra
+ *   se reduce a dos búsquedas en tabla con interpolación y dos multiplicaciones 32x32→64
+ *   (UMULL en Cortex-M3).
+ *   Las funciones y tablas se ejecutan desde SRAM (@ref RAM_FUNC), igual que las interrupciones que las llaman.
+ */
+
+#include <stddef.h>
+#include "CalculoSVM.h"
+#include "../Inc/main.h"
+
+/**
+ * @def CONST_3_PI_Q32
+ * @brief 3/π/100 en Q32. El /100 convierte el índice de modulación 0..100 a 0..1.
+ */
+#define CONST_3_PI_Q32      41013917ULL
+
+/**
+ * @brief Seno de 0° a 90° en Q15, @ref CALCULO_SVM_TABLA_N pasos.
+ * @details La última entrada es de guarda para interpolar en 90° exactos.
+ *          Generada con SVM_CalculoPuntoFijo.py.
+ */
+static const int16_t tablaSenoCuartoOnda[CALCULO_SVM_TABLA_N + 2] RAM_CONST = {
+        0,   536,  1072,  1608,  2143,  2678,  3212,  3745,  4277,  4808,
+     5338,  5866,  6393,  6917,  7441,  7962,  8481,  8997,  9512, 10024,
+    10533, 11039, 11542, 12042, 12539, 13033, 13523, 14010, 14492, 14971,
+    15446, 15917, 16383, 16846, 17303, 17756, 18204, 18648, 19086, 19519,
+    19947, 20370, 20787, 21199, 21605, 22005, 22399, 22788, 23170, 23546,
+    23915, 24279, 24636, 24986, 25329, 25666, 25996, 26319, 26635, 26943,
+    27245, 27539, 27826, 28105, 28377, 28641, 28898, 29147, 29388, 29621,
+    29846, 30064, 30273, 30474, 30667, 30852, 31028, 31196, 31356, 31507,
+    31650, 31785, 31911, 32028, 32137, 32238, 32329, 32412, 32487, 32552,
+    32609, 32657, 32697, 32728, 32749, 32763, 32767, 32767,
+};
+
+/**
+ * @brief Entrada de la tabla de sobremodulación: @ref ModulacionSVM con la ganancia relativa a ticksPeriodo (Q16).
+ */
+typedef struct EntradaSobremodulacion {
+    uint32_t gananciaRelativa;
+    uint32_t anguloRetencion;
+    uint32_t escalaRetencion;
+} EntradaSobremodulacion;
+
+/**
+ * @brief Sobremodulación para los índices @ref CALCULO_SVM_INDICE_LINEAL + 1 .. @ref CALCULO_SVM_INDICE_SEIS_PASOS.
+ * @details 105..109 modo I, 110..115 modo II, 116 seis pasos. Generada con SVM_Sobremodulacion.py.
+ */
+static const EntradaSobremodulacion tablaSobremodulacion[CALCULO_SVM_INDICE_SEIS_PASOS - CALCULO_SVM_INDICE_LINEAL] RAM_CONST = {
+    {  65730,     0,       0 },   /* 105 */
+    {  66570,     0,       0 },   /* 106 */
+    {  67633,     0,       0 },   /* 107 */
+    {  69010,     0,       0 },   /* 108 */
+    {  70991,     0,       0 },   /* 109 */
+    { 131072,   405,   66356 },   /* 110 */
+    { 131072,  3549,   73496 },   /* 111 */
+    { 131072,  7056,   83520 },   /* 112 */
+    { 131072, 11100,   99108 },   /* 113 */
+    { 131072, 16070,  128607 },   /* 114 */
+    { 131072, 23328,  227487 },   /* 115 */
+    { 131072, 32768,       0 },   /* 116 */
+};
+
+/**
+ * @details El error de cada muestra (valor pedido − ticks entregados) se suma a la siguiente: la suma de los ticks
+ *          sigue a la suma de los valores exactos y el error queda acotado, por lo que el promedio tiene la
+ *          resolución de @ref CALCULO_SVM_RESTO_BITS.
+ */
+RAM_FUNC int CalculoSVM_Cuantizar(uint64_t producto, int32_t* error) {
+#if CALCULO_SVM_ORDEN_RUIDO > 0
+    int32_t valor;
+    int ticks;
+
+    if (error != NULL) {
+        valor = (int32_t)(producto >> (31 - CALCULO_SVM_RESTO_BITS));
+#if CALCULO_SVM_ORDEN_RUIDO == 1
+        valor += error[0];
+#else
+        valor += 2 * error[0] - error[1];
+        error[1] = error[0];
+#endif
+        ticks = (valor + (1 << (CALCULO_SVM_RESTO_BITS - 1))) >> CALCULO_SVM_RESTO_BITS;
+        if (ticks < 0) {
+            /* Saturado en 0 (t cerca del borde del sector): el error se descarta para que no crezca */
+            error[0] = 0;
+            return 0;
+        }
+        error[0] = valor - (ticks << CALCULO_SVM_RESTO_BITS);
+        return ticks;
+    }
+#else
+    (void)error;
+#endif
+    /* Redondeo al tick más cercano */
+    return (int)((producto + (1UL << 30)) >> 31);
+}
+
+RAM_FUNC int32_t CalculoSVM_Seno(uint32_t angulo) {
+    uint32_t i = angulo >> CALCULO_SVM_TABLA_SHIFT;
+    int32_t f = angulo & ((1 << CALCULO_SVM_TABLA_SHIFT) - 1);
+    int32_t a = tablaSenoCuartoOnda[i];
+
+    return a + (((tablaSenoCuartoOnda[i + 1] - a) * f) >> CALCULO_SVM_TABLA_SHIFT);
+}
+
+RAM_FUNC int32_t CalculoSVM_Coseno(uint32_t fase) {
+    uint32_t angulo;
+    int32_t seno;
+
+    /* cos(x) = sen(x + 90°); 2^30 = 90° = CALCULO_SVM_ANGULO_CUARTO = 3·2^15 */
+    fase += 1UL << 30;
+    angulo = ((fase & ((1UL << 30) - 1)) * 3) >> 15;
+    if (fase & (1UL << 30)) {
+        angulo = CALCULO_SVM_ANGULO_CUARTO - angulo;
+    }
+    seno = CalculoSVM_Seno(angulo);
+    return (fase & (1UL << 31)) ? -seno : seno;
+}
+
+RAM_FUNC uint32_t CalculoSVM_AnguloSector(uint32_t fase, int* sector) {
+    uint64_t faseSector = (uint64_t)fase * 6;
+    uint32_t angulo = (uint32_t)faseSector >> 16;
+    uint32_t espejo;
+
+    *sector = (int)(faseSector >> 32);
+
+    /* Los sectores impares recorren el ángulo en espejo (60° - θ), sin saltos */
+    espejo = -(uint32_t)(*sector & 1);
+    return ((angulo ^ espejo) - espejo) + (espejo & CALCULO_SVM_ANGULO_SECTOR);
+}
+
+RAM_FUNC uint32_t CalculoSVM_Ganancia(int indiceModulacion, int ticksPeriodo) {
+    return (uint32_t)(((uint64_t)ticksPeriodo * (uint32_t)indiceModulacion * CONST_3_PI_Q32) >> 16);
+}
+
+RAM_FUNC void CalculoSVM_Modulacion(int indiceModulacion, int ticksPeriodo, ModulacionSVM* modulacion) {
+    const EntradaSobremodulacion* entrada;
+
+    if (indiceModulacion <= CALCULO_SVM_INDICE_LINEAL) {
+        modulacion->ganancia = CalculoSVM_Ganancia(indiceModulacion, ticksPeriodo);
+        modulacion->anguloRetencion = 0;
+        modulacion->escalaRetencion = 0;
+        return;
+    }
+
+    if (indiceModulacion > CALCULO_SVM_INDICE_SEIS_PASOS) {
+        indiceModulacion = CALCULO_SVM_INDICE_SEIS_PASOS;
+    }
+    entrada = &tablaSobremodulacion[indiceModulacion - CALCULO_SVM_INDICE_LINEAL - 1];
+    modulacion->ganancia = (uint32_t)ticksPeriodo * entrada->gananciaRelativa;
+    modulacion->anguloRetencion = entrada->anguloRetencion;
+    modulacion->escalaRetencion = entrada->escalaRetencion;
+}
+
+RAM_FUNC void CalculoSVM_Tiempos(uint32_t anguloSector, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, TiemposSVM* tiempos) {
+    uint32_t retencion = modulacion->anguloRetencion;
+    int t0, t1, t2;
+
+    /* Modo II: retención en los vértices y el resto del sector estirado */
+    if (retencion) {
+        if (anguloSector <= retencion) {
+            anguloSector = 0;
+        } else if (anguloSector >= CALCULO_SVM_ANGULO_SECTOR - retencion) {
+            anguloSector = CALCULO_SVM_ANGULO_SECTOR;
+        } else {
+            anguloSector = (uint32_t)(((uint64_t)(anguloSector - retencion) * modulacion->escalaRetencion) >> 16);
+        }
+    }
+
+    /* Ganancia Q16 · seno Q15 = Q31, a ticks con el error de cuantización arrastrado entre muestras */
+    t1 = CalculoSVM_Cuantizar((uint64_t)modulacion->ganancia * (uint32_t)CalculoSVM_Seno(CALCULO_SVM_ANGULO_SECTOR - anguloSector),
+                              resto ? resto->error[0] : NULL);
+    t2 = CalculoSVM_Cuantizar((uint64_t)modulacion->ganancia * (uint32_t)CalculoSVM_Seno(anguloSector),
+                              resto ? resto->error[1] : NULL);
+
+    /* Modo I: el vector fuera del hexágono se proyecta sobre su lado */
+    if (t1 + t2 > ticksPeriodo) {
+        t1 = (t1 * ticksPeriodo) / (t1 + t2);
+        t2 = ticksPeriodo - t1;
+    }
+
+    t0 = (ticksPeriodo - t1 - t2) >> 1;
+    if (t0 < 0) {
+        t0 = 0;
+    }
+
+    tiempos->t0 = t0;
+    tiempos->t1 = t1;
+    tiempos->t2 = t2;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file CalculoSVM.h
+ * @brief Núcleo de cálculo SVM en punto fijo (sin FPU).
+ * @details
+ *   Calcula los tiempos t0/t1/t2 de un sector con las ecuaciones exactas de
+ *   SVM (las mismas que `get_time_vector` en SVM_Calculos.py), usando solo
+ *   aritmética entera y una tabla de seno de cuarto de onda en Q15.
+ *
+ *   Unidades de ángulo: 65536 unidades = 60° (un sector). Con esa escala el
+ *   cuarto de onda son 98304 unidades y la tabla se indexa con un desplazamiento.
+ *
+ *   Por encima de la región lineal (índice > @ref CALCULO_SVM_INDICE_LINEAL) se pasa en forma continua
+ *   a sobremodulación modo I (la referencia se agranda y se proyecta sobre el hexágono), modo II (el vector
+ *   se retiene en el vértice) y, en @ref CALCULO_SVM_INDICE_SEIS_PASOS, seis pasos.
+ *
+ *   t1 y t2 se cuantizan a ticks con un modulador sigma-delta (@ref CALCULO_SVM_ORDEN_RUIDO): la fracción de tick
+ *   se arrastra de muestra en muestra y el promedio conserva la resolución del cálculo, no la del timer.
+ *
+ *   La tabla y el modelo bit a bit de este módulo están en
+ *   "SVM Space Vector Modulation/SVM_CalculoPuntoFijo.py"; la tabla de sobremodulación y su
+ *   verificación, en "SVM Space Vector Modulation/SVM_Sobremodulacion.py".
+ */
+
+#ifndef GESTOR_SVM_CALCULOSVM_H_
+#define GESTOR_SVM_CALCULOSVM_H_
+
+#include <stdint.h>
+
+/** @brief Ángulo de un sector (60°) en unidades de ángulo de sector. */
+#define CALCULO_SVM_ANGULO_SECTOR       65536
+/** @brief Ángulo de un cuarto de onda (90°) en unidades de ángulo de sector. */
+#define CALCULO_SVM_ANGULO_CUARTO       98304
+/** @brief Cantidad de pasos de la tabla de seno entre 0° y 90°. */
+#define CALCULO_SVM_TABLA_N             96
+/** @brief Bits de interpolación entre dos entradas de la tabla. */
+#define CALCULO_SVM_TABLA_SHIFT         10
+/** @brief Último índice de modulación de la región lineal (π/3 · 100 = 104.7). */
+#define CALCULO_SVM_INDICE_LINEAL       104
+/** @brief Índice de modulación de seis pasos (fundamental máxima 200/√3 = 115.5). */
+#define CALCULO_SVM_INDICE_SEIS_PASOS   116
+/** @brief Bits fraccionales de tick que arrastra el modulador sigma-delta de t1/t2. */
+#define CALCULO_SVM_RESTO_BITS          12
+
+/**
+ * @def CALCULO_SVM_ORDEN_RUIDO
+ * @brief Orden del modelado de ruido con que se cuantizan t1/t2 a ticks: 0 redondeo, 1 o 2 sigma-delta.
+ * @details Con índices de modulación bajos t1/t2 son pocas decenas de ticks y el redondeo se ve como ondulación de
+ *          corriente. Con 1 el error de cuantización se arrastra a la muestra siguiente (ruido empujado hacia la
+ *          frecuencia de switching); con 2 se empuja más, a costa de que cada muestra se aparte hasta ±1.5 ticks.
+ */
+#ifndef CALCULO_SVM_ORDEN_RUIDO
+#define CALCULO_SVM_ORDEN_RUIDO         1
+#endif
+
+/**
+ * @struct TiemposSVM
+ * @brief Tiempos de permanencia de cada vector en medio período del timer de switching [ticks].
+ * @details La secuencia del medio período es V0 (t0), Vx (t1), Vy (t2), V7 (t0).
+ */
+typedef struct TiemposSVM {
+    int t0;     /// Tiempo de cada vector nulo (V0 y V7).
+    int t1;     /// Tiempo del primer vector activo de la secuencia.
+    int t2;     /// Tiempo del segundo vector activo de la secuencia.
+} TiemposSVM;
+
+/**
+ * @struct ModulacionSVM
+ * @brief Parámetros de @ref CalculoSVM_Tiempos para un índice de modulación.
+ * @details Se obtienen con @ref CalculoSVM_Modulacion, fuera del cálculo por muestra.
+ */
+typedef struct ModulacionSVM {
+    uint32_t ganancia;          /// Ganancia Q16 de t1/t2. Mayor a ticksPeriodo en sobremodulación.
+    uint32_t anguloRetencion;   /// Modo II: ángulo de retención en unidades de sector (0 = sin retención).
+    uint32_t escalaRetencion;   /// Modo II: SECTOR / (SECTOR − 2·retención) en Q16.
+} ModulacionSVM;
+
+/**
+ * @struct RestoTiemposSVM
+ * @brief Estado del modulador sigma-delta de t1/t2, de una muestra a la siguiente.
+ * @details Errores de cuantización en Q@ref CALCULO_SVM_RESTO_BITS (tick = 1 << bits): [0] t1, [1] t2; el segundo
+ *          índice es la muestra anterior y la previa a esa (solo orden 2). Se arranca en cero.
+ */
+typedef struct RestoTiemposSVM {
+    int32_t error[2][2];
+} RestoTiemposSVM;
+
+/**
+ * @fn int32_t CalculoSVM_Seno(uint32_t angulo)
+ * @brief Seno por tabla de cuarto de onda con interpolación lineal.
+ * @param angulo Ángulo en unidades de sector, 0..@ref CALCULO_SVM_ANGULO_CUARTO.
+ * @return Seno en Q15 (32767 = 1.0).
+ */
+int32_t CalculoSVM_Seno(uint32_t angulo);
+
+/**
+ * @fn int32_t CalculoSVM_Coseno(uint32_t fase)
+ * @brief Coseno de una vuelta completa con la misma tabla de cuarto de onda.
+ * @param fase Ángulo de 32 bits (2^32 = 360°), como el acumulador de fase del gestor.
+ * @return Coseno en Q15, con signo.
+ * @details Los dos bits altos son el cuadrante; el resto se lleva a unidades de sector (×3/2^15, sin división).
+ */
+int32_t CalculoSVM_Coseno(uint32_t fase);
+
+/**
+ * @fn uint32_t CalculoSVM_AnguloSector(uint32_t fase, int* sector)
+ * @brief Sector y ángulo dentro del sector para una fase de 32 bits.
+ * @param fase Ángulo de 32 bits (2^32 = 360°).
+ * @param sector Sector 0..5 (parte alta de fase·6).
+ * @return Ángulo dentro del sector, 0..@ref CALCULO_SVM_ANGULO_SECTOR. Los sectores impares se recorren en espejo
+ *         (60° − θ), de modo que siempre se cuenta desde el vector de una sola fase en alto.
+ */
+uint32_t CalculoSVM_AnguloSector(uint32_t fase, int* sector);
+
+/**
+ * @fn int CalculoSVM_Cuantizar(uint64_t producto, int32_t* error)
+ * @brief Lleva un tiempo Q31 a ticks enteros con el sigma-delta de @ref CALCULO_SVM_ORDEN_RUIDO.
+ * @param producto Tiempo en ticks, Q31 (p.ej. ganancia Q16 · seno Q15), no negativo.
+ * @param error Errores de cuantización del canal (@ref RestoTiemposSVM::error), o NULL para redondear.
+ * @return Ticks, saturados en 0.
+ */
+int CalculoSVM_Cuantizar(uint64_t producto, int32_t* error);
+
+/**
+ * @fn uint32_t CalculoSVM_Ganancia(int indiceModulacion, int ticksPeriodo)
+ * @brief Calcula la ganancia (3/π)·ticks·M en Q16 que usa @ref CalculoSVM_Tiempos.
+ * @param indiceModulacion Índice de modulación 0..100.
+ * @param ticksPeriodo Ticks de medio período del timer de switching.
+ * @details Solo se recalcula cuando cambia el índice de modulación, fuera del cálculo por muestra.
+ */
+uint32_t CalculoSVM_Ganancia(int indiceModulacion, int ticksPeriodo);
+
+/**
+ * @fn void CalculoSVM_Modulacion(int indiceModulacion, int ticksPeriodo, ModulacionSVM* modulacion)
+ * @brief Calcula los parámetros de modulación para un índice 0..@ref CALCULO_SVM_INDICE_SEIS_PASOS.
+ * @param indiceModulacion Índice de modulación, proporcional a la fundamental de salida (100 = lineal con M = 1).
+ * @param ticksPeriodo Ticks de medio período del timer de switching.
+ * @param modulacion Resultado.
+ * @details Hasta @ref CALCULO_SVM_INDICE_LINEAL es @ref CalculoSVM_Ganancia sin retención. Por encima se toma
+ *          de una tabla que da la fundamental pedida; valores mayores se saturan en seis pasos.
+ */
+void CalculoSVM_Modulacion(int indiceModulacion, int ticksPeriodo, ModulacionSVM* modulacion);
+
+/**
+ * @fn void CalculoSVM_Tiempos(uint32_t anguloSector, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, TiemposSVM* tiempos)
+ * @brief Calcula t0/t1/t2 para un ángulo dentro del sector.
+ * @param anguloSector Ángulo dentro del sector, 0..@ref CALCULO_SVM_ANGULO_SECTOR.
+ * @param modulacion Parámetros obtenidos con @ref CalculoSVM_Modulacion.
+ * @param ticksPeriodo Ticks de medio período del timer de switching.
+ * @param resto Estado del sigma-delta de la secuencia de muestras, o NULL para redondear al tick más cercano.
+ * @param tiempos Resultado.
+ * @details
+ *   - Modo II: θ se lleva a 0 / 60° dentro de la retención y se estira en el resto del sector.
+ *   - t1 = ganancia · sen(60° − θ)
+ *   - t2 = ganancia · sen(θ)
+ *   - t1/t2 a ticks con el sigma-delta de orden @ref CALCULO_SVM_ORDEN_RUIDO. t0 no se modula: el reparto de los
+ *     nulos solo mueve la tensión de modo común.
+ *   - Si t1 + t2 > ticksPeriodo se proyectan sobre el lado del hexágono (t0 = 0).
+ *   - t0 = (ticksPeriodo − t1 − t2) / 2, saturado en 0.
+ */
+void CalculoSVM_Tiempos(uint32_t anguloSector, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, TiemposSVM* tiempos);
+
+#endif /* GESTOR_SVM_CALCULOSVM_H_ */
@@ -2,147 +2,286 @@
  * @file GestorSVM.cpp
  * @brief Implementación del gestor SVM (Space Vector Modulation) para control de puente trifásico con TIM3.
  * @details
- *   - TIM3 (center-aligned, ARR≈255) realiza el switching (t1/t2/t3 y RESET) por canales CCR2/CCR3/CCR4 (+ CCR1 como resync).
+ *   - TIM3 (center-aligned) realiza el switching: CCR1 en el valle (RESET) y CCR2 recorriendo la tabla de flancos del período.
  *   - TIM2 (no visible acá) actúa como timer de cálculo (productor) que alimenta un buffer circular que consume TIM3.
+ *     Es esclavo del update de TIM3 (TRGO → ITR2, modo reset), por lo que calcula siempre en la misma fase de la portadora.
  *   - Se usan parámetros “sombra” para sincronizar cambios de consigna con el lazo de cálculo en interrupciones.
- * Debido a la lentitud del calculo, este no se puede realizar en el timer de switching, el calculo demora 46us lo que representa una parte importante del ciclo. Por ello es que se involucra un timer de calculo que va a dos veces la frecuencia del de switching e intenta adelantar calculos hasta tres muestras futuras. 
+ * Debido a la lentitud del calculo, este no se puede realizar en el timer de switching, el calculo demora 46us lo que representa una parte importante del ciclo. Por ello es que se involucra un timer de calculo, enganchado por hardware al de switching, que calcula @ref SVM_CALC_DESFASE_TICKS despues de cada update: justo despues del valle en que se consumio una muestra, por lo que la siguiente queda lista con un periodo completo de adelanto.
+ * Los 46us correspondian a la regresion lineal en float (emulada por software, el F103 no tiene FPU). Ahora t0/t1/t2 se
+ * calculan en punto fijo con las ecuaciones exactas de SVM (ver @ref CalculoSVM.h).
  *
- * El proceso consumidor, el timer de switching, va a ir leyendo del indice de lectura y reduciendo el la variable numDatos.
- * El proceso productor, el timer de calculo, va a ir escribiendo en el indice de escritura y aumentando la variable numDatos
- * Si numDatos llega a 3, el proceso productor se detiene hasta que el consumidor lea algun dato.
+ * El proceso consumidor, el timer de switching, va a ir leyendo del indice de lectura y avanzandolo.
+ * El proceso productor, el timer de calculo, va a ir escribiendo en el indice de escritura y avanzandolo, hasta
+ * @ref BUFFER_CALCULO_LOTE muestras por interrupcion.
+ * Cada indice lo escribe un solo lado y la ocupacion es la diferencia entre ambos, por lo que no hay un contador
+ * compartido entre las dos prioridades de interrupcion. Si el buffer esta lleno, el productor espera a que el
+ * consumidor lea algun dato; si esta vacio cuando el consumidor lo necesita, se cuenta un faltante.
+ *
+ * Con @ref SVM_SALIDA_GPIO_DMA no se usan TIM2 ni el buffer de calculo: TIM3 cuenta intervalos entre flancos y dos canales
+ * de DMA escriben BSRR y el ARR siguiente desde una secuencia precalculada. La CPU solo recalcula una mitad del buffer
+ * en cada interrupcion de media transferencia / transferencia completa (@ref GestorSVM_DMAInterrupt).
+ *
+ * Con @ref SVM_SALIDA_TIM1 el switching lo genera TIM1 (center-aligned, PWM complementario con tiempo muerto). TIM2 y el
+ * buffer de calculo se mantienen, y el consumidor pasa a ser el update de TIM1 (una interrupcion por periodo, en el valle)
+ * que carga los CCR de precarga. TIM2 se engancha al TRGO de TIM1 (ITR0), que con RCR = 1 da un update por periodo. No hay interrupciones por flanco ni manejo de interferencias.
+ *
+ * Los flancos de cada muestra los calcula el modulador seleccionado (@ref TipoModulador, ver @ref ModuladorSVM.h): SVPWM,
+ * SPWM o THIPWM. Todos entregan el sector y ticksC1/C2/C3 ordenados, por lo que el resto del camino es el mismo.
+ *
+ * El tiempo nulo de cada periodo se reparte entre V0 y V7 segun @ref ModoPWM. En los modos discontinuos cada muestra
+ * lleva su @ref RepartoNulo: las tres salidas respetan los mismos flancos (ticksC1/C2/C3), pero el vector nulo que no
+ * se usa se reemplaza por el vector activo vecino, de modo que la pierna fija no conmuta.
+ *
+ * Con @ref SVM_SALIDA_GPIO_ISR el productor entrega cada periodo como una tabla de flancos ya ordenada (posicion y palabra
+ * BSRR), con los estados mas cortos que la latencia del ISR ya eliminados (@ref GestorSVM_ArmarFlancos). El ISR de
+ * switching solo escribe la palabra y arma el CCR del flanco siguiente.
+ *
+ * Con @ref SVM_MUESTREO_DOBLE cada entrada del buffer lleva dos muestras, una por mitad del periodo: la de subida se
+ * calcula con medio avance de fase y la de bajada con el resto. Con @ref SVM_SALIDA_GPIO_ISR la tabla deja de ser
+ * simetrica y el pico pasa a ser un limite mas, atendido por CCR3 (@ref SWITCH_INT_PICO); con @ref SVM_SALIDA_TIM1
+ * los CCR de bajada se cargan en el update del valle para que pasen a los activos en el pico.
+ *
+ * Con @ref SVM_CORRIENTE_SHUNT el productor asegura una ventana mínima a V1 y V2 de la subida y deja en la muestra el
+ * CC4 del medio de cada uno, donde TIM3 dispara las conversiones del shunt del bus. El RESET entrega las dos lecturas
+ * del período al productor, que reconstruye las corrientes de fase (@ref GestorSVM_ReconstruirCorrientes).
+ *
+ * Con @ref SVM_VBUS_FUENTE el productor filtra la tensión del bus al comienzo de cada interrupción
+ * (@ref GestorSVM_ActualizarBus) y el índice de modulación de la rampa se escala por la relación nominal/medida
+ * (@ref GestorSVM_ActualizarIndice), de modo que V/f se mantiene con el bus caído.
+ *
+ * Con @ref SVM_PERFIL cada camino de interrupción (@ref CaminoPerfilSVM) se mide con DWT->CYCCNT entre
+ * @ref PERFIL_INICIO y @ref PERFIL_FIN, y acumula mínimo, máximo, media e histograma (@ref GestorSVM_GetPerfil).
+ *
+ * Todo el estado de un puente (consigna, rampa, modulación, buffer y salida) vive en un @ref ContextoSVM. Con
+ * @ref SVM_CANTIDAD_PUENTES = 2 el puente 1 usa TIM4 y GPIOB, corrido medio período respecto de TIM3; TIM2 llena los
+ * buffers de los dos puentes y cada timer de switching consume el suyo.
  */
 
 #include <stdio.h>
 #include "GestorSVM.h"
+#include "CalculoSVM.h"
+#include "ModuladorSVM.h"
 #include "stm32f103xb.h"
 #include "../Inc/main.h"
 #include "../Gestor_Estados/GestorEstados.h"
 #include "../Gestor_Timers/GestorTimers.h"
 
 /**
- * @def MAX_TICKS
- * @brief ARR efectivo del timer de switching (resolución ≈ 256 pasos).
+ * @def TICKS_DESHABILITAR_CANAL
+ * @brief Valor mayor a cualquier ARR para forzar que un CCR nunca dispare (deshabilitar canal por “posición imposible”).
  */
-#define MAX_TICKS 256
+#define TICKS_DESHABILITAR_CANAL 0xFFFF
 
 /**
- * @def TICKS_DESHABILITAR_CANAL
- * @brief Valor mayor a ARR para forzar que un CCR nunca dispare (deshabilitar canal por “posición imposible”).
+ * @def MIN_TICKS_DIF
+ * @brief Mínima separación (en ticks) entre dos flancos de la tabla de @ref SVM_SALIDA_GPIO_ISR.
+ * @details Es la latencia del ISR, fija en tiempo: 3.9 µs a @ref SVM_FREC_TIMER (los 5 ticks con prescaler 55 de antes).
+ *          Un estado más corto se elimina en el productor (@ref GestorSVM_ArmarFlancos).
  */
-#define TICKS_DESHABILITAR_CANAL 280
+#define MIN_TICKS_DIF ((SVM_FREC_TIMER / 1000000) * 39 / 10)
 
 /**
- * @def MIN_TICKS_DIF
- * @brief Mínima separación (en ticks) entre eventos para considerar que no hay interferencia entre t1/t2/t3.
+ * @def FASE_INCREMENTO_SHIFT
+ * @brief Bits fraccionales de @ref ContextoSVM::constFrecuenciaAIncremento (Q24).
+ */
+#define FASE_INCREMENTO_SHIFT   24
+
+/**
+ * @def CONST_FRECUENCIA_A_INCREMENTO_TICK
+ * @brief Convierte @ref ContextoSVM::frecuenciaSalida (Hz×1e6) a @ref ContextoSVM::incrementoFasePorTick: 2^(32+16+1+24) / (1e6 · @ref SVM_FREC_TIMER).
+ * @details Un tick de ARR son dos ticks del timer (center-aligned). Q24, no depende de la frecuencia de switching.
+ *          2^73 no entra en 64 bits: se divide numerador y denominador por 2^10 (1e6 · 72e6 es múltiplo de 2^10).
  */
-#define MIN_TICKS_DIF 5
+#define CONST_FRECUENCIA_A_INCREMENTO_TICK  ((uint32_t)((1ULL << (32 + 16 + 1 + FASE_INCREMENTO_SHIFT - 10)) / ((1000000ULL * SVM_FREC_TIMER) >> 10)))
 
-/** @name Constantes de cálculo t1/t2 por regresión lineal
- *  @brief t1 y t2 se obtienen con una regresión lineal en función del ángulo parcial y el índice de modulación.
- *  @{ */
-#define CONST_CALC_T1_PROP      (float)-3.59145E-6
-#define CONST_CALC_T1_ORD_ORG   (float)224.2845426
-#define CONST_CALC_T2_PROP      (float)+3.59145E-6
-#define CONST_CALC_T2_ORD_ORG   (float)8.797345358
-/** @} */
+/**
+ * @def FASE_30_GRADOS
+ * @brief 30° en unidades de @ref ContextoSVM::faseActual (2^32 / 12).
+ */
+#define FASE_30_GRADOS          357913941UL
 
 /**
- * @enum CasoInterferenciaTimer
- * @brief Casos de interferencia temporal entre eventos t1/t2/t3 (demasiado cercanos).
+ * @enum RepartoNulo
+ * @brief Vectores nulos que usa un período de switching (ver @ref ModoPWM).
  */
 typedef enum {
-	INTERF_NULA = 0,        /// Sin interferencias.
-	INTERF_T1T2,            /// t1 y t2 demasiado cercanos.
-	INTERF_T1T3,            /// t1 y t3 demasiado cercanos.
-	INTERF_T2T3,            /// t2 y t3 demasiado cercanos.
-	INTERF_T1T2_T2T3        /// t1~t2 y t2~t3 simultáneamente.
-} CasoInterferenciaTimer;
-
-/** @brief Frecuencia de switching [Hz] (TIM3). */
-static int frecuenciaSwitching;
-/** @brief Sentido de rotación: 1 horario, -1 antihorario. */
-static int direccionRotacion = 1;
-/** @brief Frecuencia de salida INSTANTÁNEA (escalada ×1e6) usada por el lazo de rampa. */
-static int32_t frecuenciaSalida;
-/** @brief Incremento angular por switching (grados×1e3). */
-static uint32_t anguloSwitching;
-/** @brief Índice de modulación (0..100). Controla la tensión de salida. La relación v/f debe ser constante*/
-static volatile int indiceModulacion;
-/** @brief acelerada configurada [Hz/s]. */
-static int aceleracion;
-/** @brief Desacelerada configurada [Hz/s]. */
-static int desaceleracion;
-/** @brief Ángulo absoluto (grados×1e3). */
-static uint32_t anguloActual;
-/** @brief Ángulo parcial 0..60° (grados×1e3), usado para t1/t2. Puede ser negativo durante el diente. */
-static int32_t anguloParcial;
-/** @brief Cuadrante SVM actual (0..5). */
-static volatile int cuadranteActual;
-
-/**
- * @brief Secuencia SVM por cuadrante (V0→V1→V2→V7→V2→V1→V0).
- * @details Cada fila representa el vector lógico {U,V,W} en 7 pasos por sector.
- */
-const int vectorSecuenciaPorCuadrante[6][7] = {
-    {0b000,0b100,0b110,0b111,0b110,0b100,0b000}, // Sector 1
-    {0b000,0b010,0b110,0b111,0b110,0b010,0b000}, // Sector 2
-    {0b000,0b010,0b011,0b111,0b011,0b010,0b000}, // Sector 3
-    {0b000,0b001,0b011,0b111,0b011,0b001,0b000}, // Sector 4
-    {0b000,0b001,0b101,0b111,0b101,0b001,0b000}, // Sector 5
-    {0b000,0b100,0b101,0b111,0b101,0b100,0b000}  // Sector 6
+	NULO_V0_V7 = 0,         /// Siete segmentos: V0 y V7.
+	NULO_SOLO_V0,           /// Cinco segmentos sin V7: la pierna que enciende última queda en bajo.
+	NULO_SOLO_V7            /// Cinco segmentos sin V0: la pierna que enciende primero queda en alto.
+} RepartoNulo;
+
+/** @brief Moduladores por @ref TipoModulador. */
+static const FuncionModulador moduladores[MODULADOR_CANTIDAD] RAM_CONST = {
+	ModuladorSVM_SVPWM,
+	ModuladorSVM_SPWM,
+	ModuladorSVM_THIPWM,
 };
 
-/** @brief Mapa de qué pin conmuta en cada orden y cuadrante. */
-int pinTogglePorCuadranteYOrden[6][3];
-/** @brief Palabras BSRR precalculadas por cuadrante/estado (0/1). */
-uint32_t estadoGPIOPorCuadranteYOrden[6][2];
+/**
+ * @def SVM_SECUENCIA_SECTORES
+ * @brief Secuencia SVM por cuadrante (V0→V1→V2→V7→V2→V1→V0) como lista de filas {V1, V2}.
+ * @param FILA Macro FILA(v1, v2, a, b, c) que arma la fila de una tabla; v1/v2 son los vectores lógicos {U,V,W}.
+ * @details Las tablas que dependen de la secuencia se generan en compilación a partir de esta lista, como datos const
+ *          (@ref RAM_CONST, copiados a SRAM en el arranque). a/b/c se pasan sin cambios a cada fila (pines o bits
+ *          según la tabla).
+ */
+#define SVM_SECUENCIA_SECTORES(FILA, a, b, c) {  \
+	FILA(0b100, 0b110, a, b, c), /* Sector 1 */ \
+	FILA(0b010, 0b110, a, b, c), /* Sector 2 */ \
+	FILA(0b010, 0b011, a, b, c), /* Sector 3 */ \
+	FILA(0b001, 0b011, a, b, c), /* Sector 4 */ \
+	FILA(0b001, 0b101, a, b, c), /* Sector 5 */ \
+	FILA(0b100, 0b101, a, b, c)  /* Sector 6 */ \
+}
+
+/** @brief Palabra BSRR de una pierna: set si el bit del vector está en alto, reset si no. */
+#define SVM_BSRR_PIERNA(vector, bit, pin) \
+	(((vector) & (bit)) ? (uint32_t)(pin) : ((uint32_t)(pin) << 16))
+/** @brief Palabra BSRR completa de un vector lógico con las piernas {U,V,W} en los pines pinU/pinV/pinW. */
+#define SVM_BSRR_VECTOR(vector, pinU, pinV, pinW) \
+	(SVM_BSRR_PIERNA(vector, 0b100, pinU) | SVM_BSRR_PIERNA(vector, 0b010, pinV) | SVM_BSRR_PIERNA(vector, 0b001, pinW))
+/** @brief Fila de @ref TablasSentidoSVM::estadoGPIO: BSRR de V1 y V2 del sector. */
+#define SVM_FILA_BSRR(v1, v2, pinU, pinV, pinW) \
+	{ SVM_BSRR_VECTOR(v1, pinU, pinV, pinW), SVM_BSRR_VECTOR(v2, pinU, pinV, pinW) }
+
+/** @brief Fase (0→U, 1→V, 2→W) de un bit de vector lógico. */
+#define SVM_FASE_DE_BIT(bit) (((bit) == 0b100) ? 0 : (((bit) == 0b010) ? 1 : 2))
+/** @brief Fila de @ref faseConmutaPorCuadranteYOrden: fase que cambia en V0→V1, V1→V2 y V2→V7. */
+#define SVM_FILA_FASE_CONMUTA(v1, v2, a, b, c) \
+	{ SVM_FASE_DE_BIT(v1), SVM_FASE_DE_BIT((v1) ^ (v2)), SVM_FASE_DE_BIT((v2) ^ 0b111) }
+
+/** @brief Fase lógica (0→U, 1→V, 2→W) que enciende en ticksC1/C2/C3 por cuadrante. */
+static const uint8_t faseConmutaPorCuadranteYOrden[6][3] RAM_CONST = SVM_SECUENCIA_SECTORES(SVM_FILA_FASE_CONMUTA, 0, 0, 0);
+/**
+ * @brief Fases con corriente saliente (bits {U,V,W}) por región de 60° de la corriente.
+ * @details La región k está centrada en el vector activo de k·60°: sus fases en alto son las de corriente positiva.
+ */
+static const int corrienteSalientePorRegion[6] RAM_CONST = {0b100, 0b110, 0b010, 0b011, 0b001, 0b101};
 /** @brief BSRR para apagar U/V/W simultáneo. */
-uint32_t estadoGPIOOff;
+static const uint32_t estadoGPIOOff = (uint32_t)(GPIO_U_IN | GPIO_V_IN | GPIO_W_IN) << 16;
 /** @brief BSRR para encender U/V/W simultáneo. */
-uint32_t estadoGPIOOn;
-
-/** @brief Bandera de rampa del ángulo parcial (subida/bajada en diente). */
-static volatile char flagAscensoAnguloParcial = 1;
-/** @brief Estado lógico de salidas U/V/W (para depuración). */
-static volatile char estadoLogicoSalida[3];
-/** @brief t1/t2/t3 en ticks para el ciclo actual. */
-static volatile int ticksChannel[3];
-/** @brief Caso de interferencia detectado para el ciclo actual. */
-static volatile CasoInterferenciaTimer casoInterferencia;
-
-/** @brief Frecuencia objetivo (target) escalada ×1e6. */
-static volatile int32_t frecObjetivo;
-/** @brief Indica cambio de frecuencia en curso (rampa activa). */
-static volatile int flagChangingFrecuencia;
-/** @brief 1 si la rampa corresponde a una aceleración, 0 para desaceleración. */
-static volatile int flagEsAcelerado;
-/** @brief 1 si el motor está en movimiento. */
-static volatile int flagMotorRunning;
-/** @brief Frecuencia “de referencia” reportada (Hz). */
-static volatile int frecuenciaReferenica;
-/** @brief Delta por ciclo de switching (escalado ×1e6) para la rampa. */
-static volatile uint32_t cambioFrecuenciaPorCiclo;
+static const uint32_t estadoGPIOOn = (uint32_t)(GPIO_U_IN | GPIO_V_IN | GPIO_W_IN);
+
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+/**
+ * @brief Índice de ticksChannel (0 = t0, 1 = t0+t1, 2 = t0+t1+t2) con el que enciende una fase en el sector.
+ * @details La fase que enciende primero en la secuencia toma t0, la segunda t0+t1 y la última t0+t1+t2.
+ */
+#define SVM_INDICE_TICKS(v1, v2, bit) (((v1) & (bit)) ? 0 : (((v2) & (bit)) ? 1 : 2))
+/** @brief Fila de @ref TablasSentidoSVM::indiceTicksTIM1 para los canales {CH1, CH2, CH3} con los bits bitCH1/2/3. */
+#define SVM_FILA_TIM1(v1, v2, bitCH1, bitCH2, bitCH3) \
+	{ SVM_INDICE_TICKS(v1, v2, bitCH1), SVM_INDICE_TICKS(v1, v2, bitCH2), SVM_INDICE_TICKS(v1, v2, bitCH3) }
+#endif
+
+/**
+ * @brief Tablas de salida que dependen del sentido de giro.
+ * @details El sentido antihorario intercambia las piernas U y V. Las dos versiones están en SRAM (@ref RAM_CONST) y el
+ *          sentido se elige con @ref ContextoSVM::tablasSentido, un solo puntero.
+ */
+typedef struct {
+	uint32_t estadoGPIO[6][2];          /// BSRR de V1 y V2 por cuadrante.
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+	uint8_t indiceTicksTIM1[6][3];      /// Índice de ticksChannel para TIM1 {CH1=U, CH2=V, CH3=W} por cuadrante.
+#endif
+} TablasSentidoSVM;
+
+/** @brief Tablas por sentido: [0] horario, [1] antihorario (U↔V). */
+static const TablasSentidoSVM tablasPorSentido[2] RAM_CONST = {
+	{
+		SVM_SECUENCIA_SECTORES(SVM_FILA_BSRR, GPIO_U_IN, GPIO_V_IN, GPIO_W_IN),
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+		SVM_SECUENCIA_SECTORES(SVM_FILA_TIM1, 0b100, 0b010, 0b001),
+#endif
+	},
+	{
+		SVM_SECUENCIA_SECTORES(SVM_FILA_BSRR, GPIO_V_IN, GPIO_U_IN, GPIO_W_IN),
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+		SVM_SECUENCIA_SECTORES(SVM_FILA_TIM1, 0b010, 0b100, 0b001),
+#endif
+	},
+};
+
+/** @brief Tablas de un sentido de giro (1 horario; cualquier otro valor, antihorario). */
+#define TABLAS_SENTIDO(direccion) (&tablasPorSentido[(direccion) != 1])
+
 /** @brief Estructura auxiliar de switching usada por el ISR. */
 volatile ValoresSwitching valoresSwitching;
 
 /**
- * @brief Buffer circular (productor: timer de cálculo; consumidor: timer de switching).
- * @details Tamaño fijo 3: el productor se detiene si está lleno.
+ * @def BUFFER_CALCULO_BITS
+ * @brief log2 del tamaño del buffer circular (productor: timer de cálculo; consumidor: timer de switching).
+ * @details Con el cálculo enganchado al update del timer de switching el adelanto es fijo: el valle consume una muestra
+ *          y el cálculo la repone @ref SVM_CALC_DESFASE_TICKS después. Dos entradas alcanzan (la que se usa y la
+ *          siguiente); con el timer de cálculo libre hacían falta cuatro para absorber la deriva entre ambos.
  */
-#define BUFFER_CALCULO_SIZE 3
+#define BUFFER_CALCULO_BITS 1
 
+/**
+ * @def BUFFER_CALCULO_SIZE
+ * @brief Tamaño del buffer circular, potencia de dos: el índice se reduce con @ref BUFFER_CALCULO_MASK en lugar de %.
+ */
+#define BUFFER_CALCULO_SIZE (1U << BUFFER_CALCULO_BITS)
+
+/** @brief Máscara de índice del buffer circular. */
+#define BUFFER_CALCULO_MASK (BUFFER_CALCULO_SIZE - 1U)
+
+/**
+ * @def BUFFER_CALCULO_LOTE
+ * @brief Máximo de muestras que calcula el productor en cada interrupción del timer de cálculo.
+ * @details Con más de una, el arranque llena el buffer en una sola llamada y una interrupción perdida del timer de
+ *          cálculo se recupera en la siguiente.
+ */
+#define BUFFER_CALCULO_LOTE 2
+
+/**
+ * @def FLANCOS_POR_PERIODO
+ * @brief Máximo de flancos de un período con @ref SVM_SALIDA_GPIO_ISR: ticksC1/C2/C3 subiendo y bajando.
+ */
+#define FLANCOS_POR_PERIODO 6
+
+/**
+ * @brief Muestra calculada para un período de switching, tal como la consume el timer de switching.
+ * @details Con @ref SVM_SALIDA_GPIO_ISR es la tabla de flancos ya ordenada y sin pulsos angostos; con
+ *          @ref SVM_SALIDA_TIM1, los CCR del período por fase. Con @ref SVM_MUESTREO_DOBLE lleva las dos mitades.
+ */
 typedef struct {
-	int ticksChannel1[BUFFER_CALCULO_SIZE];
-	int ticksChannel2[BUFFER_CALCULO_SIZE];
-	int ticksChannel3[BUFFER_CALCULO_SIZE];
-	CasoInterferenciaTimer casoInterferencia[BUFFER_CALCULO_SIZE];
-	int cuadranteActual[BUFFER_CALCULO_SIZE];
-	int indiceEscritura;  					/// Índice de escritura del productor.
-	int indiceLectura;    					/// Índice de lectura del consumidor.
-	int contadorDeDatos;      				/// Elementos válidos en el buffer.
-} DatoCalculado;
+	int ticksPeriodo;                           /// ARR del período.
+#if SVM_SALIDA == SVM_SALIDA_GPIO_ISR
+	uint32_t palabraValle;                      /// BSRR que escribe el RESET en el valle del contador.
+#if SVM_MUESTREO_DOBLE
+	uint32_t palabraPico;                       /// BSRR que escribe el PICO al empezar la bajada.
+	int flancosSubida;                          /// Flancos de la tabla anteriores al pico.
+#endif
+	int cantidadFlancos;                        /// Flancos de la tabla, 0..@ref FLANCOS_POR_PERIODO.
+	uint16_t posicion[FLANCOS_POR_PERIODO];     /// CCR2 de cada flanco, en orden temporal (subiendo y luego bajando).
+	uint32_t palabra[FLANCOS_POR_PERIODO];      /// BSRR de cada flanco.
+#if SVM_CORRIENTE_SHUNT
+	uint16_t ticksMuestreo[2];                  /// CC4 de las conversiones del shunt: medio de V1 y de V2 en la subida.
+	int8_t faseMuestreo[2];                     /// Fase que mide cada conversión: 1..3 saliente de U/V/W, -1..-3 entrante.
+#endif
+#elif SVM_SALIDA == SVM_SALIDA_TIM1
+	int ccr[3];                                 /// CCR1/CCR2/CCR3 de TIM1 (fases U/V/W).
+#if SVM_MUESTREO_DOBLE
+	int ccrBajada[3];                           /// CCR de la mitad de bajada.
+#endif
+#endif
+} MuestraSVM;
 
-volatile DatoCalculado bufferCalculo;
+/**
+ * @brief Buffer circular productor/consumidor de un solo escritor por índice.
+ * @details Los índices corren libres (uint32_t) y solo se enmascaran al acceder a los arreglos:
+ *          ocupación = indiceEscritura - indiceLectura, sin ambigüedad entre lleno y vacío.
+ *          El productor escribe los datos antes de publicar @ref indiceEscritura.
+ */
+typedef struct {
+	MuestraSVM muestra[BUFFER_CALCULO_SIZE];
+	uint32_t indiceEscritura;  				/// Índice de escritura, solo lo modifica el productor.
+	uint32_t indiceLectura;    				/// Índice de lectura, solo lo modifica el consumidor.
+	uint32_t ocupacionMaxima;  				/// Estadística del productor: máximo de muestras encoladas.
+	uint32_t muestrasProducidas;			/// Estadística del productor: muestras calculadas.
+	uint32_t ocupacionMinima;  				/// Estadística del consumidor: mínimo de muestras disponibles al leer.
+	uint32_t faltantes;        				/// Estadística del consumidor: lecturas con el buffer vacío.
+} DatoCalculado;
 
 /**
  * @brief Parámetros “sombra” para sincronización atómica con el lazo de cálculo.
@@ -150,23 +289,314 @@ volatile DatoCalculado bufferCalculo;
 typedef struct {
 	int32_t frecObjetivo;
 	uint32_t cambioFrecuenciaPorCiclo;
-	int direccionRotacion;
 	int flagMotorRunning;
 	int flagEsAcelerado;
 	int flagChangingFrecuencia;
 } Parametros;
 
-volatile Parametros paramSombra;
-volatile int flagActualizarParamSombra;
+#if SVM_CORRIENTE_SHUNT
+/**
+ * @brief Conversiones del shunt de un período completo y las fases que miden (@ref MuestraSVM::faseMuestreo).
+ */
+typedef struct {
+	uint16_t lectura[2];
+	int8_t fase[2];
+} LecturaShunt;
+#endif
+
+#if SVM_VBUS_FUENTE != SVM_VBUS_NINGUNA
+/**
+ * @brief Tensión del bus, común a los puentes, y escala del índice de modulación que resulta.
+ * @details Las tensiones están en V, Q4. Solo @ref TensionBusSVM::medicion se escribe fuera del productor (SPI).
+ */
+typedef struct {
+	volatile uint32_t medicion;     /// Última medición (0 = sin medición).
+	uint32_t acumulador;            /// Estado del filtro: tensión filtrada << @ref SVM_VBUS_FILTRO_SHIFT.
+	uint32_t filtrada;              /// Tensión filtrada con la que se calculó @ref TensionBusSVM::escala.
+	uint32_t escala;                /// @ref SVM_VBUS_NOMINAL / filtrada, Q16, limitada.
+	uint32_t version;               /// Cambia con cada nueva escala; cada puente recalcula su modulación al verla.
+} TensionBusSVM;
+#endif
+
+#if SVM_PERFIL
+/**
+ * @brief Acumulado de un camino de interrupción. Cada camino lo escribe solo desde su handler.
+ * @details @ref AcumuladorPerfil::generacion distinta de @ref generacionPerfil indica que se pidió un reinicio: el
+ *          handler lo limpia antes de registrar, así el reinicio no necesita deshabilitar interrupciones.
+ */
+typedef struct {
+	uint32_t cantidad;                          /// Ejecuciones registradas; se incrementa al final de cada registro.
+	uint32_t minimo;                            /// Menor duración [ciclos].
+	uint32_t maximo;                            /// Mayor duración [ciclos].
+	uint64_t suma;                              /// Suma de las duraciones, para la media.
+	uint32_t histograma[PERFIL_SVM_CUBETAS];    /// Ejecuciones por cubeta (ver @ref PerfilSVM::histograma).
+	uint32_t generacion;                        /// @ref generacionPerfil con la que se limpió por última vez.
+} AcumuladorPerfil;
+#endif
+
+/**
+ * @brief Estado de un puente inversor: consigna, rampa, modulación, buffer de cálculo y salida.
+ * @details Hay uno por puente (@ref SVM_CANTIDAD_PUENTES) y las funciones internas reciben el contexto con el que
+ *          trabajan. La salida se fija en compilación: timer de switching, puerto de las entradas IN y SD del driver y
+ *          desplazamiento de esos pines respecto de GPIO_U_IN..GPIO_W_SD. Las tablas BSRR (@ref RAM_CONST) son las mismas
+ *          para todos los puentes; la palabra de cada estado se corre al armar la tabla de flancos.
+ */
+typedef struct ContextoSVM {
+	/** @brief Índice del puente (0..@ref SVM_CANTIDAD_PUENTES - 1). */
+	int puente;
+	/** @brief Timer de switching del puente. */
+	TIM_TypeDef* timer;
+	/** @brief Puerto de las entradas IN y SD del driver. */
+	GPIO_TypeDef* puerto;
+	/** @brief Bits que se corren los pines del puente respecto de GPIO_U_IN..GPIO_W_SD. */
+	int desplazamientoPines;
+	/** @brief Frecuencia de switching efectiva [Hz] (TIM3). */
+	int frecuenciaSwitching;
+	/** @brief ARR del timer de switching: ticks de un medio período en center-aligned (@ref SVM_FREC_TIMER / 2·@ref ContextoSVM::frecuenciaSwitching). */
+	int ticksPeriodo;
+	/** @brief Ticks de medio período que reparten t0 + t1 + t2 + t0 (@ref ContextoSVM::ticksPeriodo - 1). */
+	int ticksMedioPeriodo;
+	/** @brief Máximo apartamiento del ARR respecto de @ref ContextoSVM::ticksPeriodo con portadora aleatoria (0 = portadora fija). */
+	volatile int dispersionTicks;
+	/** @brief Dispersión de la portadora configurada [%]. */
+	int dispersionPorcentaje;
+	/** @brief Estado del generador pseudoaleatorio (xorshift32) del período de la portadora. Nunca 0. */
+	uint32_t semillaPortadora;
+	/** @brief ARR de la muestra actual: @ref ContextoSVM::ticksPeriodo, o sorteado alrededor de él con portadora aleatoria. */
+	int ticksPeriodoMuestra;
+	/** @brief Ticks de medio período de la muestra actual (@ref ContextoSVM::ticksPeriodoMuestra - 1). */
+	int ticksMedioMuestra;
+#if SVM_SINCRONO_RELACION_MAXIMA > 0
+	/** @brief Relación portadora/fundamental del PWM sincrónico (0 = portadora asincrónica). */
+	int relacionSincrona;
+	/** @brief ARR de cada muestra en sincrónico: @ref ContextoSVM::relacionSincrona muestras por ciclo de salida. */
+	int ticksSincrono;
+	/** @brief Avance de fase por muestra en sincrónico: 2^32 / @ref ContextoSVM::relacionSincrona. */
+	uint32_t avanceSincrono;
+	/** @brief @ref ContextoSVM::ticksSincrono / @ref ContextoSVM::ticksPeriodo en Q16: escala el paso de la rampa, que está calculado por período nominal. */
+	uint32_t escalaRampaSincrona;
+	/** @brief @ref ContextoSVM::modulacion recalculada para @ref ContextoSVM::ticksSincrono. */
+	ModulacionSVM modulacionSincrona;
+	/** @brief Frecuencia de switching ×1e6, para comparar con N · @ref ContextoSVM::frecuenciaSalida. */
+	uint64_t portadoraNominal;
+	/** @brief @ref ContextoSVM::portadoraNominal más la ventana de @ref SVM_SINCRONO_VENTANA_SHIFT: por encima, N baja. */
+	uint64_t portadoraMaxima;
+	/** @brief @ref ContextoSVM::portadoraNominal menos la ventana: por debajo, con la relación máxima, se vuelve a asincrónico. */
+	uint64_t portadoraMinima;
+#endif
+	/** @brief Sentido de rotación: 1 horario, -1 antihorario. */
+	int direccionRotacion;
+	/** @brief Frecuencia de salida INSTANTÁNEA (escalada ×1e6) usada por el lazo de rampa. */
+	int32_t frecuenciaSalida;
+	/** @brief Incremento de fase por muestra (2^32 = 360°). Incluye la parte fraccional del grado. */
+	uint32_t incrementoFase;
+	/** @brief Convierte @ref ContextoSVM::frecuenciaSalida (Hz×1e6) a @ref ContextoSVM::incrementoFase: 2^56 / (1e6 · @ref ContextoSVM::frecuenciaSwitching), Q24. */
+	uint32_t constFrecuenciaAIncremento;
+	/** @brief Incremento de fase por tick de ARR, Q16. Con portadora aleatoria el avance de cada muestra es proporcional a su período. */
+	uint32_t incrementoFasePorTick;
+	/** @brief Índice de modulación (0..@ref INDICE_MODULACION_MAXIMO). Controla la tensión de salida. La relación v/f debe ser constante*/
+	volatile int indiceModulacion;
+#if SVM_VBUS_FUENTE != SVM_VBUS_NINGUNA
+	/** @brief @ref TensionBusSVM::version con la que se calculó @ref ContextoSVM::indiceModulacion. */
+	uint32_t versionBus;
+#endif
+	/** @brief Parámetros de @ref CalculoSVM_Tiempos (ganancia y sobremodulación) para el @ref ContextoSVM::indiceModulacion actual. */
+	ModulacionSVM modulacion;
+	/** @brief @ref ContextoSVM::modulacion recalculada para el período de la muestra actual (solo con portadora aleatoria). */
+	ModulacionSVM modulacionMuestra;
+	/** @brief Modulación del período en curso: @ref ContextoSVM::modulacion, o @ref ContextoSVM::modulacionMuestra con portadora aleatoria. */
+	const ModulacionSVM* modulacionPeriodo;
+	/** @brief acelerada configurada [Hz/s]. */
+	int aceleracion;
+	/** @brief Desacelerada configurada [Hz/s]. */
+	int desaceleracion;
+	/**
+	 * @brief Acumulador de fase de 32 bits (2^32 = 360°). Desborda naturalmente al completar la vuelta.
+	 * @details fase · 6 deja el sector en los bits 32..34 y el ángulo dentro del sector en los 32 bits bajos.
+	 */
+	uint32_t faseActual;
+	/** @brief Cuadrante SVM actual (0..5). */
+	volatile int cuadranteActual;
+	/** @brief Modo de PWM (@ref ModoPWM) seleccionado. */
+	volatile ModoPWM modoPWM;
+	/** @brief Modo de PWM con el que se calculan las muestras: @ref ContextoSVM::modoPWM, o el que elige @ref GestorSVM_ModoHibrido. */
+	ModoPWM modoPWMActivo;
+	/** @brief Sector en el que se tomó @ref ContextoSVM::modoPWMActivo (-1 = tomarlo en la próxima muestra). */
+	int cuadranteModoPWM;
+	/** @brief Modulador (@ref TipoModulador) con el que se calculan las muestras. El productor lo lee una vez por muestra. */
+	volatile TipoModulador tipoModulador;
+	/** @brief Vectores nulos de la muestra actual, según @ref ContextoSVM::modoPWM. */
+	volatile RepartoNulo repartoNulo;
+	/** @brief Tiempo muerto a compensar en ticks, Q8 (0 = sin compensación). */
+	volatile int tiempoMuertoQ8;
+	/** @brief Atraso estimado de la corriente respecto de la tensión de referencia (2^32 = 360°). */
+	volatile uint32_t desfaseCorriente;
+	/** @brief Fracción de tick (Q8) de la compensación aún no aplicada; se arrastra entre muestras. */
+	uint32_t restoCompensacion;
+	/** @brief Error de cuantización de t1/t2 que el sigma-delta de @ref CalculoSVM_Tiempos arrastra entre muestras. */
+	RestoTiemposSVM restoTiempos;
+	/**
+	 * @brief Tablas del sentido actual.
+	 * @details El productor lo lee una vez por muestra, así que cambiarlo es una sola escritura que toma efecto entre dos
+	 *          muestras, sin mezclar sentidos dentro de un período.
+	 */
+	const TablasSentidoSVM* volatile tablasSentido;
+	/** @brief Estado lógico de salidas U/V/W (para depuración). */
+	volatile char estadoLogicoSalida[3];
+	/** @brief t1/t2/t3 en ticks para el ciclo actual. */
+	volatile int ticksChannel[3];
+	/** @brief Frecuencia objetivo (target) escalada ×1e6. */
+	volatile int32_t frecObjetivo;
+	/** @brief Indica cambio de frecuencia en curso (rampa activa). */
+	volatile int flagChangingFrecuencia;
+	/** @brief 1 si la rampa corresponde a una aceleración, 0 para desaceleración. */
+	volatile int flagEsAcelerado;
+	/** @brief 1 si el motor está en movimiento. */
+	volatile int flagMotorRunning;
+	/** @brief Frecuencia “de referencia” reportada [1/@ref FREC_RESOLUCION Hz]. */
+	volatile int frecuenciaReferenica;
+	/** @brief Delta por ciclo de switching (escalado ×1e6) para la rampa. */
+	volatile uint32_t cambioFrecuenciaPorCiclo;
+	/** @brief Buffer de cálculo del puente. */
+	volatile DatoCalculado bufferCalculo;
+	/** @brief Parámetros sombra de la rampa, copiados por @ref GestorSVM_Calculoaceleracioneracion. */
+	volatile Parametros paramSombra;
+	/** @brief 1 si hay parámetros sombra pendientes de copiar. */
+	volatile int flagActualizarParamSombra;
+#if SVM_SALIDA == SVM_SALIDA_GPIO_ISR
+	/** @brief Tabla de flancos que recorre el ISR de switching. */
+	MuestraSVM muestraSwitch;
+	/** @brief Próximo flanco de @ref ContextoSVM::muestraSwitch. */
+	int indiceFlanco;
+	/** @brief Flancos que se recorren hasta el próximo límite (pico o valle). */
+	int limiteFlancos;
+#if SVM_CORRIENTE_SHUNT
+	/** @brief Conversiones del shunt hechas en el período en curso (0..2); -1 sin período armado. */
+	volatile int indiceShunt;
+	/** @brief Conversiones del período en curso, en el orden de @ref MuestraSVM::ticksMuestreo. */
+	volatile uint16_t lecturaShunt[2];
+	/** @brief Último período con las dos conversiones, que el RESET entrega al productor. */
+	volatile LecturaShunt lecturaCompleta;
+	/** @brief 1 si @ref ContextoSVM::lecturaCompleta espera al productor; mientras tanto el RESET no la pisa. */
+	volatile int flagLecturaCompleta;
+	/** @brief Corrientes reconstruidas: las fases y los períodos los escribe el productor, los perdidos el RESET. */
+	volatile CorrientesSVM corrientes;
+#endif
+#elif SVM_SALIDA == SVM_SALIDA_TIM1
+	/** @brief Muestra que está usando TIM1; con @ref SVM_MUESTREO_DOBLE sus CCR de bajada se cargan en el valle. */
+	MuestraSVM muestraTIM1;
+#endif
+} ContextoSVM;
+
+/**
+ * @def CONTEXTO_SVM_INICIAL
+ * @brief Contexto de un puente antes de @ref GestorSVM_SetConfiguration, con su salida.
+ * @details La semilla de la portadora aleatoria cambia con el puente para que sus períodos no se sorteen iguales.
+ */
+#define CONTEXTO_SVM_INICIAL(indice, timerPuente, puertoPuente, desplazamiento) {   \
+	.puente = (indice),                                                             \
+	.timer = (timerPuente),                                                         \
+	.puerto = (puertoPuente),                                                       \
+	.desplazamientoPines = (desplazamiento),                                        \
+	.dispersionPorcentaje = DISPERSION_PORTADORA_DEFAULT,                           \
+	.semillaPortadora = 0x2545F491UL + (indice),                                    \
+	.direccionRotacion = 1,                                                         \
+	.modoPWM = MODO_PWM_DEFAULT,                                                    \
+	.modoPWMActivo = MODO_PWM_DEFAULT,                                              \
+	.cuadranteModoPWM = -1,                                                         \
+	.tipoModulador = MODULADOR_DEFAULT,                                             \
+	.tiempoMuertoQ8 = SVM_TIEMPO_MUERTO_Q8,                                         \
+	.desfaseCorriente = (uint32_t)(SVM_DESFASE_CORRIENTE * (FASE_30_GRADOS / 30)),  \
+	.tablasSentido = TABLAS_SENTIDO(1),                                             \
+}
+
+/** @brief Contexto de cada puente. */
+static ContextoSVM contextos[SVM_CANTIDAD_PUENTES] = {
+	CONTEXTO_SVM_INICIAL(0, SVM_PUENTE0_TIMER, GPIOA, 0),
+#if SVM_CANTIDAD_PUENTES > 1
+	CONTEXTO_SVM_INICIAL(1, SVM_PUENTE1_TIMER, SVM_PUENTE1_PUERTO, SVM_PUENTE1_DESPLAZAMIENTO),
+#endif
+};
+
+/** @brief Puente sobre el que actúa la API (@ref GestorSVM_SeleccionarPuente). */
+static ContextoSVM* contextoSeleccionado = &contextos[0];
+
+#if SVM_VBUS_FUENTE != SVM_VBUS_NINGUNA
+/** @brief Tensión del bus: sin medición la escala es 1 y el índice queda como el de la rampa. */
+static TensionBusSVM tensionBus = { .escala = 1UL << 16 };
+#endif
+
+#if SVM_PERFIL
+/** @brief Medición de cada camino (@ref CaminoPerfilSVM). */
+static volatile AcumuladorPerfil perfiles[PERFIL_SVM_CANTIDAD];
+
+/** @brief Se incrementa con cada @ref GestorSVM_ResetPerfil; arranca en 1 para que la primera ejecución limpie. */
+static volatile uint32_t generacionPerfil = 1;
+
+/**
+ * @def PERFIL_INICIO
+ * @brief Toma CYCCNT al comienzo del camino medido. Va al principio de un bloque, con las declaraciones.
+ */
+#define PERFIL_INICIO()         uint32_t inicioPerfil = DWT->CYCCNT
+
+/**
+ * @def PERFIL_FIN
+ * @brief Registra los ciclos desde @ref PERFIL_INICIO en el camino indicado (la resta sin signo cubre el desborde).
+ */
+#define PERFIL_FIN(camino)      GestorSVM_RegistrarPerfil((camino), DWT->CYCCNT - inicioPerfil)
+#else
+#define PERFIL_INICIO()         do { } while (0)
+#define PERFIL_FIN(camino)      do { } while (0)
+#endif
+
+/** @brief Pin de un puente: el mismo de GPIOA corrido @ref ContextoSVM::desplazamientoPines bits. */
+#define PIN_PUENTE(ctx, pin) ((uint16_t)((pin) << (ctx)->desplazamientoPines))
+
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+/**
+ * @def DMA_INTERVALOS_POR_PERIODO
+ * @brief Intervalos por período de switching: V1, V2, V7, V2, V1, V0 (V0 une el final de un período con el inicio del siguiente).
+ */
+#define DMA_INTERVALOS_POR_PERIODO  6
+
+/**
+ * @def DMA_LARGO_BUFFER
+ * @brief Entradas de cada buffer DMA (dos mitades de @ref SVM_DMA_PERIODOS_POR_MITAD períodos).
+ */
+#define DMA_LARGO_BUFFER            (2 * SVM_DMA_PERIODOS_POR_MITAD * DMA_INTERVALOS_POR_PERIODO)
+
+/**
+ * @brief Palabra BSRR de cada intervalo. TIM3_UP (DMA1 canal 3) la escribe en GPIOA->BSRR al comenzar el intervalo.
+ */
+uint32_t bufferDMABSRR[DMA_LARGO_BUFFER];
+
+/**
+ * @brief Duración - 1 de cada intervalo. TIM3_CH3 (DMA1 canal 2) la escribe en el ARR (precarga) durante el intervalo anterior.
+ */
+uint16_t bufferDMAARR[DMA_LARGO_BUFFER];
+#endif
 
 /* ================================ Prototipos privados ================================ */
 
 /**
- * @fn static void GestorSVM_Calculoaceleracioneracion(void)
- * @brief Aplica la rampa de velocidad (aceleracion/desaceleracion) sobre @ref frecuenciaSalida y actualiza flags/estado.
+ * @fn static void GestorSVM_Producir(ContextoSVM* ctx)
+ * @brief Encola hasta @ref BUFFER_CALCULO_LOTE muestras de un puente si hay espacio en su buffer.
+ */
+static void GestorSVM_Producir(ContextoSVM* ctx);
+
+/**
+ * @fn static void GestorSVM_Apagar(ContextoSVM* ctx)
+ * @brief Detiene el timer de un puente, deshabilita sus drivers, vacía el buffer y deja las salidas en bajo.
+ * @details Lo usan la rampa al llegar a 0 Hz y @ref GestorSVM_Estop.
+ */
+static void GestorSVM_Apagar(ContextoSVM* ctx);
+
+/**
+ * @fn static void GestorSVM_Calculoaceleracioneracion(ContextoSVM* ctx)
+ * @brief Aplica la rampa de velocidad (aceleracion/desaceleracion) sobre @ref ContextoSVM::frecuenciaSalida y actualiza flags/estado.
  * @details
- *   - Si @ref flagActualizarParamSombra está activo, copia los parámetros de @ref paramSombra.
- *   - Ajusta @ref frecuenciaSalida en ± @ref cambioFrecuenciaPorCiclo hasta llegar a @ref frecObjetivo.
+ *   - Si @ref ContextoSVM::flagActualizarParamSombra está activo, copia los parámetros de @ref ContextoSVM::paramSombra.
+ *   - Ajusta @ref ContextoSVM::frecuenciaSalida en ± @ref ContextoSVM::cambioFrecuenciaPorCiclo hasta llegar a @ref ContextoSVM::frecObjetivo.
  *   - Al llegar a 0 Hz: detiene timers, limpia buffer, apaga GPIO y notifica @ref ACTION_MOTOR_STOPPED.
  * @note En esta funcion se puede llegar a dar una incoherencia debido a la sincronizacion
  * de las variables sombra. Si se esta ejecutando un cambio de frecuencia en la funcion 
@@ -177,533 +607,1429 @@ volatile int flagActualizarParamSombra;
  * pasado.
  * Debido a que es un caso muy extremo no se analiza 
  */
-static void GestorSVM_Calculoaceleracioneracion(void);
+static void GestorSVM_Calculoaceleracioneracion(ContextoSVM* ctx);
+
+/**
+ * @fn static void GestorSVM_ActualizarIndice(ContextoSVM* ctx)
+ * @brief Calcula @ref ContextoSVM::indiceModulacion para @ref ContextoSVM::frecuenciaSalida y su @ref ContextoSVM::modulacion.
+ * @details V/f: 100 a 50 Hz, luego sobremodulación hasta @ref INDICE_MODULACION_MAXIMO. Con @ref SVM_VBUS_FUENTE la
+ *          frecuencia se escala por @ref TensionBusSVM::escala antes de pasar a índice, así que la corrección no pierde
+ *          la resolución del índice entero.
+ */
+static void GestorSVM_ActualizarIndice(ContextoSVM* ctx);
+
+#if SVM_VBUS_FUENTE != SVM_VBUS_NINGUNA
+/**
+ * @fn static void GestorSVM_ActualizarBus(void)
+ * @brief Toma la medición del bus, la filtra y recalcula la escala del índice si la tensión filtrada cambió.
+ * @details Una vez por interrupción del productor, antes de los puentes. Sin medición todavía, no hace nada.
+ */
+static void GestorSVM_ActualizarBus(void);
+#endif
+
+/**
+ * @fn static uint32_t GestorSVM_IniciarPeriodo(ContextoSVM* ctx)
+ * @brief Prepara un período de switching: rampa de velocidad, período y modulación.
+ * @return Avance de fase del período completo.
+ * @details Fija @ref ContextoSVM::ticksPeriodoMuestra (el del PWM sincrónico, o sorteado con portadora aleatoria) y @ref ContextoSVM::modulacionPeriodo. Se llama una vez
+ *          por período, también con @ref SVM_MUESTREO_DOBLE, así que la rampa y la portadora no cambian con el muestreo.
+ */
+static uint32_t GestorSVM_IniciarPeriodo(ContextoSVM* ctx);
+
+#if SVM_SINCRONO_RELACION_MAXIMA > 0
+/**
+ * @fn static void GestorSVM_ActualizarSincronismo(ContextoSVM* ctx)
+ * @brief Elige la relación del PWM sincrónico para @ref ContextoSVM::frecuenciaSalida y recalcula su período y modulación.
+ * @details La llama la rampa después de cambiar la frecuencia. La portadora resultante queda entre
+ *          @ref FREC_SWITCH_MINIMA y la nominal más la ventana (salvo con la relación mínima).
+ *          El avance 2^32/N no es exacto: la fase deriva medio LSB por muestra, sin saltos.
+ */
+static void GestorSVM_ActualizarSincronismo(ContextoSVM* ctx);
+#endif
+
+/**
+ * @fn static void GestorSVM_CalcularValoresSwitching(ContextoSVM* ctx, uint32_t avanceFase)
+ * @brief Calcula ticksC1/C2/C3 de la muestra y los deja en @ref ContextoSVM::ticksChannel[].
+ * @param avanceFase Avance de @ref ContextoSVM::faseActual hasta la muestra: el del período, o la mitad con @ref SVM_MUESTREO_DOBLE.
+ * @details
+ *   - Avanza @ref ContextoSVM::faseActual y llama al modulador de @ref ContextoSVM::tipoModulador, que entrega @ref ContextoSVM::cuadranteActual y los tres flancos
+ *     (ganancia y sobremodulación según @ref ContextoSVM::indiceModulacion, fracción de tick de t1/t2 arrastrada en @ref ContextoSVM::restoTiempos).
+ *   - Al entrar en un sector nuevo toma @ref ContextoSVM::modoPWMActivo de @ref ContextoSVM::modoPWM (o de @ref GestorSVM_ModoHibrido).
+ *   - Según @ref ContextoSVM::modoPWMActivo (@ref ContextoSVM::repartoNulo) los tres flancos se corren juntos hasta que C3 llega al pico (solo V0) o
+ *     C1 al valle (solo V7); t1/t2 no cambian.
+ *   - Por último, @ref GestorSVM_CompensarTiempoMuerto.
+ */
+static void GestorSVM_CalcularValoresSwitching(ContextoSVM* ctx, uint32_t avanceFase);
+
+/**
+ * @fn static ModoPWM GestorSVM_ModoHibrido(ContextoSVM* ctx)
+ * @brief Modo de @ref MODO_PWM_HIBRIDO para el sector que empieza.
+ * @return @ref MODO_PWM_SVPWM o @ref SVM_HIBRIDO_MODO_DISCONTINUO.
+ * @details Histéresis sobre @ref ContextoSVM::indiceModulacion, que la rampa (@ref GestorSVM_Calculoaceleracioneracion) mantiene
+ *          con la frecuencia de salida: entra al discontinuo en @ref SVM_HIBRIDO_INDICE_DISCONTINUO y vuelve a SVPWM en
+ *          @ref SVM_HIBRIDO_INDICE_CONTINUO. El estado es @ref ContextoSVM::modoPWMActivo.
+ */
+static ModoPWM GestorSVM_ModoHibrido(ContextoSVM* ctx);
+
+/**
+ * @fn static void GestorSVM_CompensarTiempoMuerto(ContextoSVM* ctx, int* ticks)
+ * @brief Corrige ticksC1/C2/C3 según el signo estimado de la corriente de la fase que conmuta en cada uno.
+ * @param ticks ticksC1/C2/C3 de la muestra actual.
+ * @details
+ *   - Corriente saliente: el flanco de encendido se atrasa Td, el CCR se adelanta Td/2 (alto 2·Td/2 más largo).
+ *   - Corriente entrante: el apagado se atrasa Td, el CCR se atrasa Td/2.
+ *   - El signo sale de la región de 60° de @ref ContextoSVM::faseActual atrasada @ref ContextoSVM::desfaseCorriente.
+ *   - La pierna fija de DPWM no se corrige. El resultado se satura manteniendo C1 <= C2 <= C3.
+ */
+static void GestorSVM_CompensarTiempoMuerto(ContextoSVM* ctx, int* ticks);
+
+#if SVM_SALIDA == SVM_SALIDA_GPIO_ISR
+/**
+ * @fn static void GestorSVM_SwitchInterrupt(ContextoSVM* ctx, SwitchInterruptType intType)
+ * @brief Handler interno llamado por el ISR de TIM3 según la fuente (RESET, FLANCO, CLEAN).
+ * @param intType Fuente de interrupción @ref SwitchInterruptType.
+ * @details
+ *   - RESET (CCR1, valle): consume una muestra, escribe ARR y la palabra del valle y arma CCR2 con el primer flanco.
+ *   - FLANCO (CCR2): escribe la palabra del flanco y arma CCR2 con el siguiente. Recorre la tabla sin decisiones.
+ *   - PICO (CCR3, solo @ref SVM_MUESTREO_DOBLE): escribe la palabra del pico y arma CCR2 con el primer flanco de bajada.
+ *     Hasta el pico solo se recorren los flancos de subida.
+ *   - CLEAN: descarta la tabla en curso.
+ */
+static void GestorSVM_SwitchInterrupt(ContextoSVM* ctx, SwitchInterruptType intType);
+
+/**
+ * @fn static void GestorSVM_EstadosSubida(ContextoSVM* ctx, uint32_t* estado)
+ * @brief Palabras BSRR de los cuatro estados del medio período de subida de la muestra actual: valle, V1, V2 y pico.
+ * @param estado Destino, 4 palabras. El vector nulo que no usa @ref ContextoSVM::repartoNulo se reemplaza por el activo vecino.
+ */
+static void GestorSVM_EstadosSubida(ContextoSVM* ctx, uint32_t* estado);
+
+/**
+ * @fn static int GestorSVM_ArmarMedioPeriodo(const uint32_t* estado, const int* tiempo, int tiempoMaximo, int* inicio, int* tiempoFlanco, int* antes, int* despues)
+ * @brief Flancos de un medio período entre dos límites atendidos por el ISR, sin estados más cortos que @ref MIN_TICKS_DIF.
+ * @param estado Los cuatro estados en orden temporal.
+ * @param tiempo Tiempos de las tres transiciones desde el límite inicial, no decrecientes.
+ * @param tiempoMaximo Último tiempo admitido para un flanco; uno posterior queda demasiado cerca del límite final.
+ * @param inicio Estado con el que arranca el medio período (índice de estado).
+ * @param tiempoFlanco Tiempos de los flancos que quedan.
+ * @param antes Estado previo a cada flanco (índice de estado).
+ * @param despues Estado posterior a cada flanco (índice de estado).
+ * @return Cantidad de flancos, 0..3.
+ */
+static int GestorSVM_ArmarMedioPeriodo(const uint32_t* estado, const int* tiempo, int tiempoMaximo, int* inicio, int* tiempoFlanco, int* antes, int* despues);
+
+/**
+ * @fn static void GestorSVM_ArmarFlancos(ContextoSVM* ctx, MuestraSVM* muestra)
+ * @brief Convierte @ref ContextoSVM::ticksChannel y @ref ContextoSVM::cuadranteActual en la tabla de flancos de un período.
+ * @param muestra Destino de la tabla.
+ * @details
+ *   - Estados del medio período: valle, V1, V2, pico. El vector nulo que no usa @ref ContextoSVM::repartoNulo se reemplaza por el
+ *     activo vecino y su flanco, que no cambia ninguna pierna, no entra en la tabla.
+ *   - Un estado más corto que @ref MIN_TICKS_DIF se elimina: dos flancos cercanos se unen en el punto medio con la
+ *     palabra del último, un flanco cerca del valle pasa a la palabra del valle y un pulso angosto en el pico se descarta.
+ *     Se hace igual en subida y en bajada, así que la tabla es simétrica y el primer flanco de bajada queda al menos
+ *     @ref MIN_TICKS_DIF después del último de subida.
+ *   - Se repite hasta que todos los flancos quedan separados entre sí, del valle y del pico.
+ *   - Con @ref SVM_MUESTREO_DOBLE solo arma la subida; el pico tiene su propia interrupción y los flancos deben quedar
+ *     a @ref MIN_TICKS_DIF de él. La bajada la agrega @ref GestorSVM_ArmarFlancosBajada con la muestra siguiente.
+ */
+static void GestorSVM_ArmarFlancos(ContextoSVM* ctx, MuestraSVM* muestra);
+
+#if SVM_MUESTREO_DOBLE
+/**
+ * @fn static void GestorSVM_ArmarFlancosBajada(ContextoSVM* ctx, MuestraSVM* muestra)
+ * @brief Agrega a la tabla de @ref GestorSVM_ArmarFlancos los flancos de bajada de la muestra actual.
+ * @param muestra Tabla con la subida ya armada.
+ * @details Los estados se recorren al revés desde el pico; un flanco cerca del pico pasa a la palabra del pico y uno
+ *          cerca del valle se descarta, con las mismas reglas que la subida.
+ */
+static void GestorSVM_ArmarFlancosBajada(ContextoSVM* ctx, MuestraSVM* muestra);
+#endif
+
+#if SVM_CORRIENTE_SHUNT
+/**
+ * @fn static void GestorSVM_PrepararMuestreo(ContextoSVM* ctx, MuestraSVM* muestra, int* desplazamiento)
+ * @brief Estira V1 y V2 de la subida hasta @ref SVM_CORRIENTE_VENTANA_MINIMA y fija los puntos de muestreo del shunt.
+ * @param muestra Destino de @ref MuestraSVM::ticksMuestreo y @ref MuestraSVM::faseMuestreo.
+ * @param desplazamiento Corrimiento aplicado a cada ticksC1/C2/C3, para que @ref GestorSVM_CompensarVentana lo descuente.
+ * @details
+ *   - V1 corto: se adelanta ticksC1; si no entra desde el valle, se atrasa ticksC2.
+ *   - V2 corto: se atrasa ticksC3; si no entra antes del pico, se adelanta ticksC2 (y ticksC1 si hace falta).
+ *   - Las conversiones van en el medio de cada ventana, la primera no antes de @ref SVM_CORRIENTE_MUESTREO_MINIMO.
+ *   La tabla de flancos solo puede agrandar las ventanas (elimina estados nulos cortos), así que los puntos quedan
+ *   dentro de sus vectores.
+ */
+static void GestorSVM_PrepararMuestreo(ContextoSVM* ctx, MuestraSVM* muestra, int* desplazamiento);
+
+/**
+ * @fn static void GestorSVM_CompensarVentana(ContextoSVM* ctx, const int* desplazamiento, int cuadrante)
+ * @brief Descuenta en la bajada el corrimiento de @ref GestorSVM_PrepararMuestreo, pierna por pierna.
+ * @param desplazamiento Corrimiento de cada flanco en la subida.
+ * @param cuadrante Sector de la subida.
+ * @details Cada pierna está en alto desde su CCR de subida hasta su CCR de bajada: correr uno y el otro lo mismo
+ *          deja igual el tiempo en alto del período. Si la bajada ya es de otro sector sus flancos son de otras
+ *          fases y el corrimiento de esa muestra no se compensa.
+ */
+static void GestorSVM_CompensarVentana(ContextoSVM* ctx, const int* desplazamiento, int cuadrante);
+
+/**
+ * @fn static int GestorSVM_FaseVector(uint32_t palabra)
+ * @brief Fase cuya corriente circula por el bus durante un vector activo.
+ * @param palabra BSRR del vector (puente 0).
+ * @return 1..3 si la fase U/V/W es la única en alto (corriente saliente); -1..-3 si es la única en bajo (entrante).
+ */
+static int GestorSVM_FaseVector(uint32_t palabra);
+
+/**
+ * @fn static void GestorSVM_ReconstruirCorrientes(ContextoSVM* ctx)
+ * @brief Convierte el último período entregado por el RESET en las corrientes de fase (@ref ContextoSVM::corrientes).
+ * @details Las dos conversiones dan dos fases distintas (V1 y V2 son vecinos); la tercera es menos la suma. Se llama
+ *          en cada interrupción del productor y no hace nada si no hay un período nuevo.
+ */
+static void GestorSVM_ReconstruirCorrientes(ContextoSVM* ctx);
+#endif
+#endif
+
+/**
+ * @fn static int GestorSVM_SortearPeriodo(ContextoSVM* ctx)
+ * @brief Sortea el ARR del próximo período con portadora aleatoria: @ref ContextoSVM::ticksPeriodo ± @ref ContextoSVM::dispersionTicks, uniforme.
+ * @details xorshift32 y una multiplicación 32x32→64 para llevarlo al rango, sin divisiones.
+ */
+static int GestorSVM_SortearPeriodo(ContextoSVM* ctx);
+
+/**
+ * @fn static int GestorSVM_LeerBuffer(ContextoSVM* ctx, MuestraSVM* muestra)
+ * @brief Lado consumidor del buffer de cálculo: retira la muestra más antigua.
+ * @param muestra Destino de la muestra; no se modifica si el buffer estaba vacío.
+ * @return 1 si había una muestra; 0 si el buffer estaba vacío (se cuenta en @ref DatoCalculado::faltantes).
+ */
+static int GestorSVM_LeerBuffer(ContextoSVM* ctx, MuestraSVM* muestra);
+
+/**
+ * @fn static void GestorSVM_VaciarBuffer(ContextoSVM* ctx)
+ * @brief Descarta las muestras pendientes y reinicia las estadísticas. Solo con los timers detenidos.
+ */
+static void GestorSVM_VaciarBuffer(ContextoSVM* ctx);
+
+#if SVM_PERFIL
+/**
+ * @fn static void GestorSVM_RegistrarPerfil(CaminoPerfilSVM camino, uint32_t ciclos)
+ * @brief Suma una ejecución de un camino: mínimo, máximo, suma y cubeta del histograma (log2 con CLZ, sin divisiones).
+ * @details Solo desde el handler del camino, que no se interrumpe a sí mismo.
+ */
+static void GestorSVM_RegistrarPerfil(CaminoPerfilSVM camino, uint32_t ciclos);
+#endif
+
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+/**
+ * @fn static void GestorSVM_ArmarPeriodoDMA(ContextoSVM* ctx, uint32_t* palabras, uint16_t* duraciones)
+ * @brief Convierte @ref ContextoSVM::ticksChannel y @ref ContextoSVM::cuadranteActual en los seis intervalos de un período para el DMA.
+ * @param palabras Destino de las palabras BSRR (@ref DMA_INTERVALOS_POR_PERIODO entradas).
+ * @param duraciones Destino de los ARR (duración - 1) de cada intervalo.
+ * @details
+ *   - Duraciones: t1, t2, 2·(@ref ContextoSVM::ticksPeriodoMuestra - ticksC3), t2, t1, 2·t0. Suman 2·@ref ContextoSVM::ticksPeriodoMuestra, igual que TIM3 en center-aligned.
+ *   - El vector nulo que no usa @ref ContextoSVM::repartoNulo se escribe con el vector activo vecino (sin flanco).
+ *   - Un intervalo menor a @ref SVM_DMA_MIN_TICKS se elimina adelantando el estado siguiente; el período no cambia.
+ */
+static void GestorSVM_ArmarPeriodoDMA(ContextoSVM* ctx, uint32_t* palabras, uint16_t* duraciones);
+#endif
+
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+/**
+ * @fn static void GestorSVM_ArmarCCRTIM1(ContextoSVM* ctx, int* ccr)
+ * @brief Convierte @ref ContextoSVM::ticksChannel y @ref ContextoSVM::cuadranteActual en los CCR de TIM1 {CH1=U, CH2=V, CH3=W} del período.
+ * @param ccr Destino de los CCR (@ref MuestraSVM::ccr, o @ref MuestraSVM::ccrBajada con @ref SVM_MUESTREO_DOBLE).
+ * @details El mapeo fase/ticks sale de @ref ContextoSVM::tablasSentido al calcular la muestra, así que un cambio de sentido
+ *          nunca se mezcla con muestras ya encoladas.
+ */
+static void GestorSVM_ArmarCCRTIM1(ContextoSVM* ctx, int* ccr);
+
+/**
+ * @fn static void GestorSVM_ActualizarTIM1(ContextoSVM* ctx)
+ * @brief Consume una entrada del buffer de cálculo y la escribe en CCR1..CCR3 de TIM1.
+ * @details Los CCR tienen precarga: los valores pasan a los registros activos en el próximo update (valle del contador),
+ *          por lo que el período en curso no se altera. Con @ref SVM_MUESTREO_DOBLE se llama en el update del pico.
+ */
+static void GestorSVM_ActualizarTIM1(ContextoSVM* ctx);
+
+#if SVM_MUESTREO_DOBLE
+/**
+ * @fn static void GestorSVM_ActualizarTIM1Bajada(ContextoSVM* ctx)
+ * @brief Escribe los CCR de bajada de la muestra en curso. Se llama en el update del valle y pasan a los activos en el pico.
+ */
+static void GestorSVM_ActualizarTIM1Bajada(ContextoSVM* ctx);
+#endif
+#endif
+
+/* ================================ Implementación privada ================================ */
+
+static RAM_FUNC uint32_t GestorSVM_IniciarPeriodo(ContextoSVM* ctx) {
+	/* Rampa de velocidad si corresponde */
+	if (ctx->flagChangingFrecuencia) {
+		GestorSVM_Calculoaceleracioneracion(ctx);
+	}
+#if SVM_VBUS_FUENTE != SVM_VBUS_NINGUNA
+	else if (ctx->versionBus != tensionBus.version) {
+		/* Cambió la tensión del bus: la misma frecuencia pide otro índice */
+		GestorSVM_ActualizarIndice(ctx);
+#if SVM_SINCRONO_RELACION_MAXIMA > 0
+		if (ctx->relacionSincrona) {
+			CalculoSVM_Modulacion(ctx->indiceModulacion, ctx->ticksSincrono - 1, &ctx->modulacionSincrona);
+		}
+#endif
+	}
+#endif
+
+#if SVM_SINCRONO_RELACION_MAXIMA > 0
+	if (ctx->relacionSincrona) {
+		/* PWM sincrónico: N muestras iguales por ciclo, la fase avanza 360°/N en cada una */
+		ctx->ticksPeriodoMuestra = ctx->ticksSincrono;
+		ctx->ticksMedioMuestra = ctx->ticksSincrono - 1;
+		ctx->modulacionPeriodo = &ctx->modulacionSincrona;
+		return ctx->avanceSincrono;
+	}
+#endif
+
+	if (ctx->dispersionTicks) {
+		/* Portadora aleatoria: ganancia y avance de fase proporcionales al período sorteado */
+		ctx->ticksPeriodoMuestra = GestorSVM_SortearPeriodo(ctx);
+		ctx->ticksMedioMuestra = ctx->ticksPeriodoMuestra - 1;
+		CalculoSVM_Modulacion(ctx->indiceModulacion, ctx->ticksMedioMuestra, &ctx->modulacionMuestra);
+		ctx->modulacionPeriodo = &ctx->modulacionMuestra;
+		return (uint32_t)(((uint64_t)ctx->incrementoFasePorTick * (uint32_t)ctx->ticksPeriodoMuestra) >> 16);
+	}
+
+	ctx->ticksPeriodoMuestra = ctx->ticksPeriodo;
+	ctx->ticksMedioMuestra = ctx->ticksMedioPeriodo;
+	ctx->modulacionPeriodo = &ctx->modulacion;
+	return ctx->incrementoFase;
+}
+
+static RAM_FUNC void GestorSVM_CalcularValoresSwitching(ContextoSVM* ctx, uint32_t avanceFase) {
+	SalidaModulador salida;
+	uint32_t anguloSector;
+	int sector;
+	int desplazamiento;
+	int ticks[3];
+
+	/* Avance de fase: el desborde de 32 bits es la vuelta completa */
+	ctx->faseActual += avanceFase;
+
+	/* Sector y flancos ordenados del modulador seleccionado */
+	moduladores[ctx->tipoModulador](ctx->faseActual, ctx->modulacionPeriodo, ctx->ticksMedioMuestra, &ctx->restoTiempos, &salida);
+	ctx->cuadranteActual = salida.sector;
+
+	/* El modo cambia solo en el borde de un sector, donde la secuencia de conmutación cambia igual */
+	if (ctx->cuadranteActual != ctx->cuadranteModoPWM) {
+		ctx->cuadranteModoPWM = ctx->cuadranteActual;
+		ctx->modoPWMActivo = (ctx->modoPWM == MODO_PWM_HIBRIDO) ? GestorSVM_ModoHibrido(ctx) : ctx->modoPWM;
+	}
+
+	/* Vectores nulos del período según el modo de PWM */
+	switch (ctx->modoPWMActivo) {
+		case MODO_PWM_DPWM0:
+			ctx->repartoNulo = (ctx->cuadranteActual & 1) ? NULO_SOLO_V7 : NULO_SOLO_V0;
+			break;
+		case MODO_PWM_DPWM1:
+			/* θ cuenta desde el vector de una sola fase en alto: antes de 30° esa fase es la de mayor tensión */
+			anguloSector = CalculoSVM_AnguloSector(ctx->faseActual, &sector);
+			ctx->repartoNulo = (anguloSector < CALCULO_SVM_ANGULO_SECTOR / 2) ? NULO_SOLO_V7 : NULO_SOLO_V0;
+			break;
+		case MODO_PWM_DPWM2:
+			ctx->repartoNulo = (ctx->cuadranteActual & 1) ? NULO_SOLO_V0 : NULO_SOLO_V7;
+			break;
+		case MODO_PWM_DPWMMIN:
+			ctx->repartoNulo = NULO_SOLO_V0;
+			break;
+		default:
+			ctx->repartoNulo = NULO_V0_V7;
+			break;
+	}
+
+	/* Un solo vector nulo: los tres flancos se corren juntos, el tiempo de los activos no cambia */
+	if (ctx->repartoNulo == NULO_SOLO_V0) {
+		desplazamiento = ctx->ticksMedioMuestra - salida.ticks[2];
+	} else if (ctx->repartoNulo == NULO_SOLO_V7) {
+		desplazamiento = -salida.ticks[0];
+	} else {
+		desplazamiento = 0;
+	}
+	ticks[0] = salida.ticks[0] + desplazamiento;
+	ticks[1] = salida.ticks[1] + desplazamiento;
+	ticks[2] = salida.ticks[2] + desplazamiento;
+
+	GestorSVM_CompensarTiempoMuerto(ctx, ticks);
+
+	ctx->ticksChannel[0] = ticks[0];
+	ctx->ticksChannel[1] = ticks[1];
+	ctx->ticksChannel[2] = ticks[2];
+}
+
+static RAM_FUNC ModoPWM GestorSVM_ModoHibrido(ContextoSVM* ctx) {
+	if (ctx->modoPWMActivo == SVM_HIBRIDO_MODO_DISCONTINUO) {
+		return (ctx->indiceModulacion <= SVM_HIBRIDO_INDICE_CONTINUO) ? MODO_PWM_SVPWM : SVM_HIBRIDO_MODO_DISCONTINUO;
+	}
+	return (ctx->indiceModulacion >= SVM_HIBRIDO_INDICE_DISCONTINUO) ? SVM_HIBRIDO_MODO_DISCONTINUO : MODO_PWM_SVPWM;
+}
+
+static RAM_FUNC int GestorSVM_SortearPeriodo(ContextoSVM* ctx) {
+	uint32_t x = ctx->semillaPortadora;
+	int rango = ctx->dispersionTicks;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	ctx->semillaPortadora = x;
+
+	/* x · (2·rango + 1) / 2^32 es uniforme en 0..2·rango */
+	return ctx->ticksPeriodo - rango + (int)(((uint64_t)x * (uint32_t)(2 * rango + 1)) >> 32);
+}
+
+static RAM_FUNC void GestorSVM_CompensarTiempoMuerto(ContextoSVM* ctx, int* ticks) {
+	uint32_t region;
+	int saliente;
+	int compensacion;
+	int fase;
+	int k, desde, hasta;
+
+	if (ctx->tiempoMuertoQ8 == 0) {
+		return;
+	}
+
+	/* Td/2 por CCR; la fracción de tick se acumula y se aplica en las muestras siguientes */
+	ctx->restoCompensacion += (uint32_t)ctx->tiempoMuertoQ8 >> 1;
+	compensacion = (int)(ctx->restoCompensacion >> 8);
+	ctx->restoCompensacion &= 0xFF;
+	if (compensacion == 0) {
+		return;
+	}
+
+	/* Región de 60° de la corriente: redondeo al vector activo más cercano */
+	region = (uint32_t)(((uint64_t)(ctx->faseActual - ctx->desfaseCorriente + FASE_30_GRADOS) * 6) >> 32);
+	saliente = corrienteSalientePorRegion[region];
+
+	desde = (ctx->repartoNulo == NULO_SOLO_V7) ? 1 : 0;
+	hasta = (ctx->repartoNulo == NULO_SOLO_V0) ? 2 : 3;
+	for (k = desde; k < hasta; k++) {
+		fase = faseConmutaPorCuadranteYOrden[ctx->cuadranteActual][k];
+		if (saliente & (0b100 >> fase)) {
+			ticks[k] -= compensacion;
+		} else {
+			ticks[k] += compensacion;
+		}
+	}
+
+	if (ticks[0] < 0) {
+		ticks[0] = 0;
+	}
+	if (ticks[2] > ctx->ticksMedioMuestra) {
+		ticks[2] = ctx->ticksMedioMuestra;
+	}
+	if (ticks[1] < ticks[0]) {
+		ticks[1] = ticks[0];
+	}
+	if (ticks[1] > ticks[2]) {
+		ticks[1] = ticks[2];
+	}
+	if (ticks[0] > ticks[1]) {
+		ticks[0] = ticks[1];
+	}
+}
+
+#if SVM_SALIDA == SVM_SALIDA_GPIO_ISR
+static RAM_FUNC void GestorSVM_EstadosSubida(ContextoSVM* ctx, uint32_t* estado) {
+	const uint32_t* estadoSector = ctx->tablasSentido->estadoGPIO[ctx->cuadranteActual];
+
+	estado[0] = (ctx->repartoNulo == NULO_SOLO_V7) ? estadoSector[0] : estadoGPIOOff;
+	estado[1] = estadoSector[0];
+	estado[2] = estadoSector[1];
+	estado[3] = (ctx->repartoNulo == NULO_SOLO_V0) ? estadoSector[1] : estadoGPIOOn;
+
+	/* Las tablas están armadas para los pines del puente 0 */
+	estado[0] <<= ctx->desplazamientoPines;
+	estado[1] <<= ctx->desplazamientoPines;
+	estado[2] <<= ctx->desplazamientoPines;
+	estado[3] <<= ctx->desplazamientoPines;
+}
+
+static RAM_FUNC int GestorSVM_ArmarMedioPeriodo(const uint32_t* estado, const int* tiempo, int tiempoMaximo, int* inicio, int* tiempoFlanco, int* antes, int* despues) {
+	int cantidad = 0;
+	int eliminado;
+	int i, k;
+
+	/* Flancos que cambian alguna pierna */
+	*inicio = 0;
+	for (k = 0; k < 3; k++) {
+		if (estado[k + 1] != estado[k]) {
+			tiempoFlanco[cantidad] = tiempo[k];
+			antes[cantidad] = k;
+			despues[cantidad] = k + 1;
+			cantidad++;
+		}
+	}
+
+	/* Eliminación de pulsos angostos */
+	do {
+		eliminado = 0;
+		if (cantidad > 0 && tiempoFlanco[0] < MIN_TICKS_DIF) {
+			/* Cerca del límite inicial: el medio período arranca directamente en el estado siguiente */
+			*inicio = despues[0];
+			for (i = 1; i < cantidad; i++) {
+				tiempoFlanco[i - 1] = tiempoFlanco[i];
+				antes[i - 1] = antes[i];
+				despues[i - 1] = despues[i];
+			}
+			cantidad--;
+			eliminado = 1;
+		} else if (cantidad > 0 && tiempoFlanco[cantidad - 1] > tiempoMaximo) {
+			/* Pulso angosto contra el límite final: se mantiene el estado anterior */
+			cantidad--;
+			eliminado = 1;
+		} else {
+			for (i = 0; i + 1 < cantidad; i++) {
+				if (tiempoFlanco[i + 1] - tiempoFlanco[i] < MIN_TICKS_DIF) {
+					/* Dos flancos cercanos: uno solo en el punto medio, el estado intermedio desaparece */
+					tiempoFlanco[i] = (tiempoFlanco[i] + tiempoFlanco[i + 1]) >> 1;
+					despues[i] = despues[i + 1];
+					for (k = i + 2; k < cantidad; k++) {
+						tiempoFlanco[k - 1] = tiempoFlanco[k];
+						antes[k - 1] = antes[k];
+						despues[k - 1] = despues[k];
+					}
+					cantidad--;
+					eliminado = 1;
+					break;
+				}
+			}
+		}
+	} while (eliminado);
+
+	return cantidad;
+}
+
+static RAM_FUNC void GestorSVM_ArmarFlancos(ContextoSVM* ctx, MuestraSVM* muestra) {
+	uint32_t estado[4];
+	int tiempo[3];
+	int posicion[3];
+	int antes[3], despues[3];
+	int valle;
+	int cantidad;
+	int periodo = ctx->ticksPeriodoMuestra;
+	int i;
+
+	/* Estados del medio período de subida: valle, V1, V2 y pico */
+	GestorSVM_EstadosSubida(ctx, estado);
+	tiempo[0] = ctx->ticksChannel[0];
+	tiempo[1] = ctx->ticksChannel[1];
+	tiempo[2] = ctx->ticksChannel[2];
+
+	muestra->ticksPeriodo = periodo;
+#if SVM_MUESTREO_DOBLE
+	/* El pico es un límite con su propia interrupción: los flancos quedan a MIN_TICKS_DIF de él */
+	cantidad = GestorSVM_ArmarMedioPeriodo(estado, tiempo, periodo - MIN_TICKS_DIF, &valle, posicion, antes, despues);
+
+	muestra->palabraValle = estado[valle];
+	muestra->flancosSubida = cantidad;
+	muestra->cantidadFlancos = cantidad;
+	for (i = 0; i < cantidad; i++) {
+		muestra->posicion[i] = (uint16_t)posicion[i];
+		muestra->palabra[i] = estado[despues[i]];
+	}
+#else
+	/* Sin interrupción en el pico el estado del pico dura 2·(periodo - posición): basta con la mitad de MIN_TICKS_DIF */
+	cantidad = GestorSVM_ArmarMedioPeriodo(estado, tiempo, periodo - (MIN_TICKS_DIF + 1) / 2, &valle, posicion, antes, despues);
+
+	/* Flancos de subida en orden y los mismos de bajada al revés, volviendo al estado anterior */
+	muestra->palabraValle = estado[valle];
+	muestra->cantidadFlancos = 2 * cantidad;
+	for (i = 0; i < cantidad; i++) {
+		muestra->posicion[i] = (uint16_t)posicion[i];
+		muestra->palabra[i] = estado[despues[i]];
+		muestra->posicion[2 * cantidad - 1 - i] = (uint16_t)posicion[i];
+		muestra->palabra[2 * cantidad - 1 - i] = estado[antes[i]];
+	}
+#endif
+}
+
+#if SVM_MUESTREO_DOBLE
+static RAM_FUNC void GestorSVM_ArmarFlancosBajada(ContextoSVM* ctx, MuestraSVM* muestra) {
+	uint32_t subida[4];
+	uint32_t estado[4];
+	int tiempo[3];
+	int desdePico[3];
+	int antes[3], despues[3];
+	int pico;
+	int cantidad;
+	int periodo = muestra->ticksPeriodo;
+	int base = muestra->cantidadFlancos;
+	int i;
+
+	/* Estados desde el pico hacia el valle, tiempos contados desde el pico */
+	GestorSVM_EstadosSubida(ctx, subida);
+	for (i = 0; i < 4; i++) {
+		estado[i] = subida[3 - i];
+	}
+	for (i = 0; i < 3; i++) {
+		tiempo[i] = periodo - ctx->ticksChannel[2 - i];
+	}
+
+	cantidad = GestorSVM_ArmarMedioPeriodo(estado, tiempo, periodo - MIN_TICKS_DIF, &pico, desdePico, antes, despues);
+
+	muestra->palabraPico = estado[pico];
+	muestra->cantidadFlancos = base + cantidad;
+	for (i = 0; i < cantidad; i++) {
+		muestra->posicion[base + i] = (uint16_t)(periodo - desdePico[i]);
+		muestra->palabra[base + i] = estado[despues[i]];
+	}
+}
+#endif
+
+#if SVM_CORRIENTE_SHUNT
+static RAM_FUNC void GestorSVM_PrepararMuestreo(ContextoSVM* ctx, MuestraSVM* muestra, int* desplazamiento) {
+	uint32_t estado[4];
+	int ticks[3];
+	int limite = ctx->ticksMedioMuestra;
+	int medio;
+	int k;
+
+	ticks[0] = ctx->ticksChannel[0];
+	ticks[1] = ctx->ticksChannel[1];
+	ticks[2] = ctx->ticksChannel[2];
+
+	if (ticks[1] - ticks[0] < SVM_CORRIENTE_VENTANA_MINIMA) {
+		ticks[0] = ticks[1] - SVM_CORRIENTE_VENTANA_MINIMA;
+		if (ticks[0] < 0) {
+			ticks[0] = 0;
+			ticks[1] = SVM_CORRIENTE_VENTANA_MINIMA;
+		}
+	}
+	if (ticks[2] - ticks[1] < SVM_CORRIENTE_VENTANA_MINIMA) {
+		ticks[2] = ticks[1] + SVM_CORRIENTE_VENTANA_MINIMA;
+		if (ticks[2] > limite) {
+			ticks[2] = limite;
+			ticks[1] = limite - SVM_CORRIENTE_VENTANA_MINIMA;
+			if (ticks[0] > ticks[1] - SVM_CORRIENTE_VENTANA_MINIMA) {
+				ticks[0] = ticks[1] - SVM_CORRIENTE_VENTANA_MINIMA;
+			}
+		}
+	}
+
+	for (k = 0; k < 3; k++) {
+		desplazamiento[k] = ticks[k] - ctx->ticksChannel[k];
+		ctx->ticksChannel[k] = ticks[k];
+	}
+
+	/* Medio de cada vector activo y la fase que circula por el shunt en él */
+	medio = (ticks[0] + ticks[1]) >> 1;
+	muestra->ticksMuestreo[0] = (uint16_t)((medio < SVM_CORRIENTE_MUESTREO_MINIMO) ? SVM_CORRIENTE_MUESTREO_MINIMO : medio);
+	muestra->ticksMuestreo[1] = (uint16_t)((ticks[1] + ticks[2]) >> 1);
+
+	GestorSVM_EstadosSubida(ctx, estado);
+	muestra->faseMuestreo[0] = (int8_t)GestorSVM_FaseVector(estado[1]);
+	muestra->faseMuestreo[1] = (int8_t)GestorSVM_FaseVector(estado[2]);
+}
+
+static RAM_FUNC void GestorSVM_CompensarVentana(ContextoSVM* ctx, const int* desplazamiento, int cuadrante) {
+	int ticks[3];
+	int limite = ctx->ticksMedioMuestra;
+	int k;
+
+	if (ctx->cuadranteActual != cuadrante) {
+		return;
+	}
+
+	/* El CCR de bajada se corre al revés que el de subida; la saturación mantiene C1 <= C2 <= C3 */
+	for (k = 0; k < 3; k++) {
+		ticks[k] = ctx->ticksChannel[k] - desplazamiento[k];
+		if (ticks[k] < ((k > 0) ? ticks[k - 1] : 0)) {
+			ticks[k] = (k > 0) ? ticks[k - 1] : 0;
+		}
+		if (ticks[k] > limite) {
+			ticks[k] = limite;
+		}
+	}
+
+	ctx->ticksChannel[0] = ticks[0];
+	ctx->ticksChannel[1] = ticks[1];
+	ctx->ticksChannel[2] = ticks[2];
+}
+
+static RAM_FUNC int GestorSVM_FaseVector(uint32_t palabra) {
+	int u = (palabra & GPIO_U_IN) != 0;
+	int v = (palabra & GPIO_V_IN) != 0;
+	int w = (palabra & GPIO_W_IN) != 0;
+
+	if (u + v + w == 1) {
+		return u ? 1 : (v ? 2 : 3);
+	}
+	return !u ? -1 : (!v ? -2 : -3);
+}
+
+static RAM_FUNC void GestorSVM_ReconstruirCorrientes(ContextoSVM* ctx) {
+	int32_t medida[2];
+	int fase[2];
+	int k;
+
+	if (!ctx->flagLecturaCompleta) {
+		return;
+	}
+
+	for (k = 0; k < 2; k++) {
+		medida[k] = (((int32_t)ctx->lecturaCompleta.lectura[k] - SVM_CORRIENTE_CERO_ADC) * SVM_CORRIENTE_MA_POR_CUENTA_Q8) >> 8;
+		fase[k] = ctx->lecturaCompleta.fase[k];
+		if (fase[k] < 0) {
+			/* Única pierna en bajo: la corriente del bus es la que entra por ella */
+			medida[k] = -medida[k];
+			fase[k] = -fase[k];
+		}
+		fase[k]--;
+	}
+
+	/* Libera la lectura: el próximo RESET ya puede entregar otra */
+	ctx->flagLecturaCompleta = 0;
+
+	ctx->corrientes.fase[fase[0]] = medida[0];
+	ctx->corrientes.fase[fase[1]] = medida[1];
+	ctx->corrientes.fase[3 - fase[0] - fase[1]] = -(medida[0] + medida[1]);
+	ctx->corrientes.periodos++;
+}
+#endif
+
+static RAM_FUNC void GestorSVM_SwitchInterrupt(ContextoSVM* ctx, SwitchInterruptType intType) {
+	MuestraSVM* muestra = &ctx->muestraSwitch;
+
+	switch (intType) {
+		case SWITCH_INT_FLANCO:
+			ctx->puerto->BSRR = muestra->palabra[ctx->indiceFlanco];
+			ctx->indiceFlanco++;
+			ctx->timer->CCR2 = (ctx->indiceFlanco < ctx->limiteFlancos) ? muestra->posicion[ctx->indiceFlanco] : TICKS_DESHABILITAR_CANAL;
+			break;
+
+		case SWITCH_INT_RESET:
+#if SVM_CORRIENTE_SHUNT
+			/* Lecturas del período que termina, con las fases de su tabla, para el productor */
+			if (ctx->indiceShunt == 2) {
+				if (!ctx->flagLecturaCompleta) {
+					ctx->lecturaCompleta.lectura[0] = ctx->lecturaShunt[0];
+					ctx->lecturaCompleta.lectura[1] = ctx->lecturaShunt[1];
+					ctx->lecturaCompleta.fase[0] = muestra->faseMuestreo[0];
+					ctx->lecturaCompleta.fase[1] = muestra->faseMuestreo[1];
+					ctx->flagLecturaCompleta = 1;
+				}
+			} else if (ctx->indiceShunt >= 0) {
+				ctx->corrientes.perdidos++;
+			}
+#endif
+			/* Sin muestra nueva se repite la tabla anterior (se cuenta como faltante) */
+			GestorSVM_LeerBuffer(ctx, muestra);
+
+			/* ARR sin precarga: el período que empieza ya dura lo que pide la muestra */
+			ctx->timer->ARR = muestra->ticksPeriodo;
+			ctx->puerto->BSRR = muestra->palabraValle;
+#if SVM_CORRIENTE_SHUNT
+			/* CC4 sin precarga: la primera conversión es la de V1 de este mismo período */
+			ctx->timer->CCR4 = muestra->ticksMuestreo[0];
+			ctx->indiceShunt = 0;
+#endif
+			ctx->indiceFlanco = 0;
+#if SVM_MUESTREO_DOBLE
+			ctx->timer->CCR3 = muestra->ticksPeriodo;
+			ctx->limiteFlancos = muestra->flancosSubida;
+#else
+			ctx->limiteFlancos = muestra->cantidadFlancos;
+#endif
+			ctx->timer->CCR2 = (ctx->limiteFlancos > 0) ? muestra->posicion[0] : TICKS_DESHABILITAR_CANAL;
+			break;
+
+#if SVM_MUESTREO_DOBLE
+		case SWITCH_INT_PICO:
+			ctx->puerto->BSRR = muestra->palabraPico;
+			ctx->indiceFlanco = muestra->flancosSubida;
+			ctx->limiteFlancos = muestra->cantidadFlancos;
+			ctx->timer->CCR2 = (ctx->indiceFlanco < ctx->limiteFlancos) ? muestra->posicion[ctx->indiceFlanco] : TICKS_DESHABILITAR_CANAL;
+			break;
+#endif
+
+		case SWITCH_INT_CLEAN:
+			muestra->cantidadFlancos = 0;
+			ctx->indiceFlanco = 0;
+			ctx->limiteFlancos = 0;
+			ctx->timer->CCR2 = TICKS_DESHABILITAR_CANAL;
+#if SVM_MUESTREO_DOBLE
+			ctx->timer->CCR3 = TICKS_DESHABILITAR_CANAL;
+#endif
+#if SVM_CORRIENTE_SHUNT
+			ctx->timer->CCR4 = TICKS_DESHABILITAR_CANAL;
+			ctx->indiceShunt = -1;
+#endif
+			break;
 
-/**
- * @fn static int pinMap(int x)
- * @brief Convierte el XOR de estados (bit U/V/W) al índice interno {0,1,2}.
- * @param x Máscara de pin que cambia (1bit activo entre U/V/W).
- * @return Índice 0→U, 1→V, 2→W.
- */
-static int pinMap(int x);
+		default:
+			break;
+	}
+}
+#endif
 
-/**
- * @fn static void GestorSVM_CalcularValoresSwitching(void)
- * @brief Calcula t1, t2 y t0 (y casos de interferencia) y los deja en @ref ticksChannel[].
- * @details
- *   - Actualiza ángulos ( @ref anguloActual y @ref anguloParcial) y @ref cuadranteActual.
- *   - t1/t2 por regresión lineal (constantes @ref CONST_CALC_T* y @ref indiceModulacion).
- *   - t0 = (255 - t1 - t2)/2. Luego: ticksC1=t0, ticksC2=t0+t1, ticksC3=t0+t1+t2.
- *   - Clasifica interferencias según @ref MIN_TICKS_DIF y setea @ref casoInterferencia.
- */
-static void GestorSVM_CalcularValoresSwitching(void);
+static RAM_FUNC int GestorSVM_LeerBuffer(ContextoSVM* ctx, MuestraSVM* muestra) {
+	uint32_t indiceLectura = ctx->bufferCalculo.indiceLectura;
+	uint32_t ocupacion = ctx->bufferCalculo.indiceEscritura - indiceLectura;
+	uint32_t i;
 
-/**
- * @fn static void GestorSVM_SwitchInterrupt(SwitchInterruptType intType)
- * @brief Handler interno llamado por el ISR de TIM3 según la fuente (CH1..CH4, RESET, CLEAN).
- * @param intType Fuente de interrupción @ref SwitchInterruptType.
- * @details
- *   - RESET: consume una entrada del buffer y precarga CCR2/CCR3/CCR4.
- *   - CH1/CH2/CH3: conmuta GPIO según orden/fase y maneja interferencias habilitando/deshabilitando CCxIE.
- *   - CLEAN: limpia flags y estado interno del switching.
- */
-static void GestorSVM_SwitchInterrupt(SwitchInterruptType intType);
+	if (ocupacion == 0) {
+		ctx->bufferCalculo.faltantes++;
+		return 0;
+	}
+	if (ocupacion < ctx->bufferCalculo.ocupacionMinima) {
+		ctx->bufferCalculo.ocupacionMinima = ocupacion;
+	}
 
-/**
- * @fn static void GestorSVM_SwitchPuertos(OrdenSwitch orden, char estado, int numCuadrante)
- * @brief Escribe en BSRR los pines correspondientes a la orden y cuadrante.
- * @param orden Orden de conmutación @ref OrdenSwitch.
- * @param estado 0=primer estado del sector, 1=segundo estado (usa @ref estadoGPIOPorCuadranteYOrden).
- * @param numCuadrante Sector SVM (0..5).
- */
-static void GestorSVM_SwitchPuertos(OrdenSwitch orden, char estado, int numCuadrante);
+	i = indiceLectura & BUFFER_CALCULO_MASK;
+	*muestra = ctx->bufferCalculo.muestra[i];
 
-/* ================================ Implementación privada ================================ */
+	/* Libera la posición recién después de copiar los datos */
+	ctx->bufferCalculo.indiceLectura = indiceLectura + 1;
+	return 1;
+}
+
+static void GestorSVM_VaciarBuffer(ContextoSVM* ctx) {
+	ctx->bufferCalculo.indiceEscritura    = 0;
+	ctx->bufferCalculo.indiceLectura      = 0;
+	ctx->bufferCalculo.ocupacionMaxima    = 0;
+	ctx->bufferCalculo.muestrasProducidas = 0;
+	ctx->bufferCalculo.ocupacionMinima    = BUFFER_CALCULO_SIZE;
+	ctx->bufferCalculo.faltantes          = 0;
+}
 
-static int pinMap(int x) {
-    int r = 0;
-    x &= 0x07; // limitar a 3 bits (U,V,W)
-    if (x == 1) {
-		r = 2;   // W
+#if SVM_PERFIL
+static RAM_FUNC void GestorSVM_RegistrarPerfil(CaminoPerfilSVM camino, uint32_t ciclos) {
+	volatile AcumuladorPerfil* perfil = &perfiles[camino];
+	uint32_t generacion = generacionPerfil;
+	int cubeta;
+	int i;
+
+	if (perfil->generacion != generacion) {
+		perfil->cantidad = 0;
+		perfil->minimo = 0xFFFFFFFF;
+		perfil->maximo = 0;
+		perfil->suma = 0;
+		for (i = 0; i < PERFIL_SVM_CUBETAS; i++) {
+			perfil->histograma[i] = 0;
+		}
+		perfil->generacion = generacion;
+	}
+
+	/* Cubeta = log2(ciclos): el bit más alto encendido */
+	cubeta = 31 - __CLZ(ciclos | 1);
+	if (cubeta >= PERFIL_SVM_CUBETAS) {
+		cubeta = PERFIL_SVM_CUBETAS - 1;
 	}
-    else if (x == 2) {
-		r = 1;   // V
+
+	if (ciclos < perfil->minimo) {
+		perfil->minimo = ciclos;
 	}
-    else if (x == 4) {
-		r = 0;   // U
+	if (ciclos > perfil->maximo) {
+		perfil->maximo = ciclos;
 	}
-	return r;
+	perfil->suma += ciclos;
+	perfil->histograma[cubeta]++;
+
+	/* Último: la lectura usa la cantidad para detectar un registro en el medio de la copia */
+	perfil->cantidad++;
 }
+#endif
 
-static void GestorSVM_CalcularValoresSwitching() {
-	int t1, t2, t0;
-	int ticksC1, ticksC2, ticksC3;
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+static RAM_FUNC void GestorSVM_ArmarPeriodoDMA(ContextoSVM* ctx, uint32_t* palabras, uint16_t* duraciones) {
+	const uint32_t* estadoSector = ctx->tablasSentido->estadoGPIO[ctx->cuadranteActual];
+	int duracion[DMA_INTERVALOS_POR_PERIODO];
+	int faltante, tomado;
+	int i;
 
-	/* Rampa de velocidad si corresponde */
-	if (flagChangingFrecuencia) {
-		GestorSVM_Calculoaceleracioneracion();
+	palabras[0] = estadoSector[0];
+	palabras[1] = estadoSector[1];
+	palabras[2] = (ctx->repartoNulo == NULO_SOLO_V0) ? palabras[1] : estadoGPIOOn;
+	palabras[3] = estadoSector[1];
+	palabras[4] = estadoSector[0];
+	palabras[5] = (ctx->repartoNulo == NULO_SOLO_V7) ? palabras[4] : estadoGPIOOff;
+
+	duracion[0] = ctx->ticksChannel[1] - ctx->ticksChannel[0];
+	duracion[1] = ctx->ticksChannel[2] - ctx->ticksChannel[1];
+	duracion[2] = 2 * (ctx->ticksPeriodoMuestra - ctx->ticksChannel[2]);
+	duracion[3] = duracion[1];
+	duracion[4] = duracion[0];
+	duracion[5] = 2 * ctx->ticksChannel[0];
+
+	/* Intervalo corto: el estado siguiente se adelanta y absorbe la diferencia */
+	for (i = 0; i < DMA_INTERVALOS_POR_PERIODO - 1; i++) {
+		if (duracion[i] < SVM_DMA_MIN_TICKS) {
+			duracion[i + 1] -= SVM_DMA_MIN_TICKS - duracion[i];
+			duracion[i] = SVM_DMA_MIN_TICKS;
+			palabras[i] = palabras[i + 1];
+		}
 	}
 
-	/* Avance angular y gestión de diente 0..60° */
-	anguloActual += anguloSwitching;
-	if (anguloActual >= 360 * 1000 * 1000) {
-		anguloActual -= 360 * 1000 * 1000;
-		cuadranteActual = 0;
-		flagAscensoAnguloParcial = 1;
-		anguloParcial = anguloActual;
-	} else {
-		if (flagAscensoAnguloParcial == 1) {
-			anguloParcial += anguloSwitching;
-			if (anguloParcial >= 60 * 1000 * 1000) {
-				anguloParcial = 2 * 60 * 1000 * 1000 - anguloParcial; // espejo
-				flagAscensoAnguloParcial = 0;
-				cuadranteActual = (cuadranteActual + 1) % 6;
-			}
-		} else {
-			anguloParcial -= anguloSwitching;
-			if (anguloParcial <= 0) {
-				anguloParcial = -anguloParcial; // espejo
-				flagAscensoAnguloParcial = 1;
-				cuadranteActual = (cuadranteActual + 1) % 6;
-			}
+	/* V0 no tiene siguiente dentro del período: completa su mínimo con los intervalos anteriores */
+	faltante = SVM_DMA_MIN_TICKS - duracion[DMA_INTERVALOS_POR_PERIODO - 1];
+	for (i = DMA_INTERVALOS_POR_PERIODO - 2; i >= 0 && faltante > 0; i--) {
+		tomado = duracion[i] - SVM_DMA_MIN_TICKS;
+		if (tomado > faltante) {
+			tomado = faltante;
 		}
+		duracion[i] -= tomado;
+		faltante -= tomado;
 	}
-
-	/* t1/t2 por regresión e índice de modulación */
-	t1 = (int)(((CONST_CALC_T1_PROP * (float)anguloParcial + CONST_CALC_T1_ORD_ORG) * indiceModulacion) / 100);
-	t2 = (int)(((CONST_CALC_T2_PROP * (float)anguloParcial + CONST_CALC_T2_ORD_ORG) * indiceModulacion) / 100);
-	t0 = (int)((float)(255 - t1 - t2) * 0.5);
-
-	/* Ticks absolutos en el período */
-	ticksC1 = t0;
-	ticksC2 = t0 + t1;
-	ticksC3 = t0 + t1 + t2;
-
-	/* Clasificación de interferencias */
-	if (ticksC3 - ticksC1 < MIN_TICKS_DIF) {
-		casoInterferencia = INTERF_T1T3;
-	} else if (ticksC2 - ticksC1 < MIN_TICKS_DIF && ticksC3 - ticksC2 < MIN_TICKS_DIF) {
-		casoInterferencia = INTERF_T1T2_T2T3;
-	} else if (ticksC2 - ticksC1 < MIN_TICKS_DIF) {
-		casoInterferencia = INTERF_T1T2;
-	} else if (ticksC3 - ticksC2 < MIN_TICKS_DIF) {
-		casoInterferencia = INTERF_T2T3;
-	} else {
-		casoInterferencia = INTERF_NULA;
+	if (duracion[DMA_INTERVALOS_POR_PERIODO - 1] < SVM_DMA_MIN_TICKS) {
+		duracion[DMA_INTERVALOS_POR_PERIODO - 1] = SVM_DMA_MIN_TICKS;
 	}
 
-	ticksChannel[0] = ticksC1;
-	ticksChannel[1] = ticksC2;
-	ticksChannel[2] = ticksC3;
+	for (i = 0; i < DMA_INTERVALOS_POR_PERIODO; i++) {
+		duraciones[i] = (uint16_t)(duracion[i] - 1);
+	}
 }
+#endif
+
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+static RAM_FUNC void GestorSVM_ArmarCCRTIM1(ContextoSVM* ctx, int* ccr) {
+	const uint8_t* indiceTicks = ctx->tablasSentido->indiceTicksTIM1[ctx->cuadranteActual];
+	int ticks[3];
 
-static void GestorSVM_SwitchInterrupt(SwitchInterruptType intType) {
-	volatile static int countUpTx[3];               // 1=subiendo, 0=bajando
-	volatile static int flagTxActivo[3];            // espera de evento por canal
-	volatile static CasoInterferenciaTimer interferencia;
-	volatile static int cuadrante = 0;
-	int ticks1, ticks2, ticks3;
+	ticks[0] = ctx->ticksChannel[0];
+	ticks[1] = ctx->ticksChannel[1];
+	/* Sin V7 la fase que enciende última no debe llegar a encender (ticksC3 = ARR - 1 daría un pulso de 2 ticks) */
+	ticks[2] = (ctx->repartoNulo == NULO_SOLO_V0) ? TICKS_DESHABILITAR_CANAL : ctx->ticksChannel[2];
+
+	ccr[0] = ticks[indiceTicks[0]];
+	ccr[1] = ticks[indiceTicks[1]];
+	ccr[2] = ticks[indiceTicks[2]];
+}
 
-	/* Si no hay datos precargados, no hacer nada */
-	if (bufferCalculo.contadorDeDatos <= 0) {
+static RAM_FUNC void GestorSVM_ActualizarTIM1(ContextoSVM* ctx) {
+	/* Sin datos se repite el período anterior (los CCR de precarga no cambian) */
+	if (!GestorSVM_LeerBuffer(ctx, &ctx->muestraTIM1)) {
 		return;
 	}
 
-	switch (intType) {
-		case SWITCH_INT_CH1:
-			if (flagTxActivo[0]) {
-				flagTxActivo[0] = 0;
-				if (countUpTx[0]) {
-					GestorSVM_SwitchPuertos(ORDEN_SWITCH_1_UP, 1, cuadrante);
-					countUpTx[0] = 0;
-				} else {
-					countUpTx[0] = 1;
-					GestorSVM_SwitchPuertos(ORDEN_SWITCH_1_DOWN, 0, cuadrante);
-					/* Rehabilita interrupciones de los otros canales */
-					TIM3->DIER |= TIM_DIER_CC2IE;
-					TIM3->DIER |= TIM_DIER_CC3IE;
-					TIM3->DIER |= TIM_DIER_CC4IE;
-				}
-			} else {
-				flagTxActivo[0] = 1;
-			}
-			break;
+	/* PWM2 center-aligned: la fase está en alto mientras CNT >= CCR. ARR y CCR pasan juntos en el próximo valle */
+	ctx->timer->ARR = ctx->muestraTIM1.ticksPeriodo;
+	ctx->timer->CCR1 = ctx->muestraTIM1.ccr[0];
+	ctx->timer->CCR2 = ctx->muestraTIM1.ccr[1];
+	ctx->timer->CCR3 = ctx->muestraTIM1.ccr[2];
+}
 
-		case SWITCH_INT_CH2:
-			if (flagTxActivo[1]) {
-				flagTxActivo[1] = 0;
-				if (countUpTx[1]) {
-					GestorSVM_SwitchPuertos(ORDEN_SWITCH_2_UP, 1, cuadrante);
-					countUpTx[1] = 0;
-				} else {
-					GestorSVM_SwitchPuertos(ORDEN_SWITCH_2_DOWN, 0, cuadrante);
-					countUpTx[1] = 1;
-				}
-			} else {
-				if (interferencia == INTERF_T1T2_T2T3) {
-					flagTxActivo[1] = 0;
-					TIM3->DIER &= ~TIM_DIER_CC3IE; // desactiva T2
-				} else {
-					flagTxActivo[1] = 1;
-				}
-			}
-			break;
+#if SVM_MUESTREO_DOBLE
+static RAM_FUNC void GestorSVM_ActualizarTIM1Bajada(ContextoSVM* ctx) {
+	/* Sin datos nuevos en el pico anterior se repite la bajada de la misma muestra */
+	ctx->timer->CCR1 = ctx->muestraTIM1.ccrBajada[0];
+	ctx->timer->CCR2 = ctx->muestraTIM1.ccrBajada[1];
+	ctx->timer->CCR3 = ctx->muestraTIM1.ccrBajada[2];
+}
+#endif
+#endif
 
-		case SWITCH_INT_CH3:
-			if (flagTxActivo[2]) {
-				flagTxActivo[2] = 0;
-				if (countUpTx[2]) {
-					GestorSVM_SwitchPuertos(ORDEN_SWITCH_3_UP, 1, cuadrante);
-
-					/* Manejo de interferencias */
-					switch (interferencia) {
-						case INTERF_NULA:
-							flagTxActivo[0] = 1;
-							flagTxActivo[1] = 1;
-							flagTxActivo[2] = 1;
-							break;
-						case INTERF_T1T2:
-							flagTxActivo[0] = 0;  // T1 pendiente
-							flagTxActivo[1] = 0;  // desactiva T2
-							flagTxActivo[2] = 1;
-							// Deshabilitacion T2
-							TIM3->DIER &= ~TIM_DIER_CC3IE;
-							// Activacion T1
-							TIM3->DIER |= TIM_DIER_CC2IE;
-							break;
-						case INTERF_T2T3:
-							flagTxActivo[0] = 1;
-							flagTxActivo[1] = 0;  // T2 pendiente
-							flagTxActivo[2] = 0;  // T3 off
-							TIM3->DIER &= ~TIM_DIER_CC4IE; // CC4 off
-							TIM3->DIER |=  TIM_DIER_CC3IE; // CC3 on
-							break;
-						case INTERF_T1T3:
-							/* No debe ocurrir aquí */
-							break;
-						case INTERF_T1T2_T2T3:
-							flagTxActivo[0] = 0;
-							flagTxActivo[1] = 0;
-							flagTxActivo[2] = 1;
-							TIM3->DIER &= ~TIM_DIER_CC3IE; // CC3 off
-							TIM3->DIER |=  TIM_DIER_CC2IE; // CC2 on
-							break;
-					}
-					/* Próximas interrupciones: cuenta abajo */
-					countUpTx[0] = 0;
-					countUpTx[1] = 0;
-					countUpTx[2] = 0;
-				} else {
-					GestorSVM_SwitchPuertos(ORDEN_SWITCH_3_DOWN, 0, cuadrante);
-					countUpTx[2] = 1;
-				}
-			} else {
-				if (interferencia == INTERF_T1T3) {
-					flagTxActivo[0] = 0;
-					flagTxActivo[1] = 0;
-					flagTxActivo[2] = 0;
-				} else {
-					flagTxActivo[2] = 1;
-				}
-			}
-			break;
+static RAM_FUNC void GestorSVM_Apagar(ContextoSVM* ctx) {
+	ctx->flagMotorRunning = 0;
+	GestorTimers_DetenerTimerSVM(ctx->puente);
 
-		case SWITCH_INT_RESET:
-			/* Re-sync / precarga */
-			countUpTx[0] = 1;
-			countUpTx[1] = 1;
-			countUpTx[2] = 1;
-
-			/* Consume entrada del buffer */
-			ticks1 = bufferCalculo.ticksChannel1[bufferCalculo.indiceLectura];
-			ticks2 = bufferCalculo.ticksChannel2[bufferCalculo.indiceLectura];
-			ticks3 = bufferCalculo.ticksChannel3[bufferCalculo.indiceLectura];
-			interferencia = bufferCalculo.casoInterferencia[bufferCalculo.indiceLectura];
-			cuadrante = bufferCalculo.cuadranteActual[bufferCalculo.indiceLectura];
-			bufferCalculo.indiceLectura = (bufferCalculo.indiceLectura + 1) % BUFFER_CALCULO_SIZE;
-			bufferCalculo.contadorDeDatos--;
-
-			/* Habilitación según interferencias */
-			switch (interferencia) {
-				case INTERF_NULA:
-					flagTxActivo[0] = 1;
-					flagTxActivo[1] = 1;
-					flagTxActivo[2] = 1;
-					TIM3->DIER |= TIM_DIER_CC2IE;
-					TIM3->DIER |= TIM_DIER_CC3IE;
-					TIM3->DIER |= TIM_DIER_CC4IE;
-					break;
-				case INTERF_T1T2:
-					flagTxActivo[0] = 0;
-					flagTxActivo[1] = 1;
-					flagTxActivo[2] = 1;
-					TIM3->DIER &= ~TIM_DIER_CC2IE;
-					TIM3->DIER |= TIM_DIER_CC3IE;
-					TIM3->DIER |= TIM_DIER_CC4IE;
-					break;
-				case INTERF_T2T3:
-					flagTxActivo[0] = 1;
-					flagTxActivo[1] = 0;
-					flagTxActivo[2] = 1;
-					TIM3->DIER |= TIM_DIER_CC2IE;
-					TIM3->DIER &= ~TIM_DIER_CC3IE;
-					TIM3->DIER |= TIM_DIER_CC4IE;
-					break;
-				case INTERF_T1T3:
-					flagTxActivo[0] = 0;
-					flagTxActivo[1] = 0;
-					flagTxActivo[2] = 0;
-					/* Carga posiciones distantes (nunca disparan simultáneo) */
-					ticks1 = 20;
-					ticks2 = 60;
-					ticks3 = 100;			
-					TIM3->DIER |= TIM_DIER_CC2IE;
-					TIM3->DIER |= TIM_DIER_CC3IE;
-					TIM3->DIER |= TIM_DIER_CC4IE;
-					break;
-				case INTERF_T1T2_T2T3:
-					// Desactivacion de T1 y Activacion de T2 y T3
-					flagTxActivo[0] = 0;
-					flagTxActivo[1] = 1;
-					flagTxActivo[2] = 1;
-					TIM3->DIER &= ~TIM_DIER_CC2IE;
-					TIM3->DIER |= TIM_DIER_CC3IE;
-					TIM3->DIER |= TIM_DIER_CC4IE;
-					break;
-			}
+	/* Drivers deshabilitados antes de tocar las entradas */
+	HAL_GPIO_WritePin(ctx->puerto, PIN_PUENTE(ctx, GPIO_U_SD), GPIO_PIN_RESET);
+	HAL_GPIO_WritePin(ctx->puerto, PIN_PUENTE(ctx, GPIO_V_SD), GPIO_PIN_RESET);
+	HAL_GPIO_WritePin(ctx->puerto, PIN_PUENTE(ctx, GPIO_W_SD), GPIO_PIN_RESET);
 
-			/* Precarga CCRs (t1→CCR2, t2→CCR3, t3→CCR4) */
-			TIM3->CCR2 = ticks1;
-			TIM3->CCR3 = ticks2;
-			TIM3->CCR4 = ticks3;
-			break;
+#if SVM_SALIDA == SVM_SALIDA_GPIO_ISR
+	GestorSVM_SwitchInterrupt(ctx, SWITCH_INT_CLEAN);
+#endif
 
-		case SWITCH_INT_CLEAN:
-			/* Limpieza de estado */
-			countUpTx[0] = 1;
-			countUpTx[1] = 1;
-			countUpTx[2] = 1;
-			flagTxActivo[0] = 0;
-			flagTxActivo[1] = 0;
-			flagTxActivo[2] = 0;
-			break;
+	/* Limpia buffer productor/consumidor */
+	GestorSVM_VaciarBuffer(ctx);
 
-		default:
-			break;
-	}
+	HAL_GPIO_WritePin(ctx->puerto, PIN_PUENTE(ctx, GPIO_U_IN), GPIO_PIN_RESET);
+	HAL_GPIO_WritePin(ctx->puerto, PIN_PUENTE(ctx, GPIO_V_IN), GPIO_PIN_RESET);
+	HAL_GPIO_WritePin(ctx->puerto, PIN_PUENTE(ctx, GPIO_W_IN), GPIO_PIN_RESET);
 }
 
-static void GestorSVM_SwitchPuertos(OrdenSwitch orden, char estado, int numCuadrante) {
-	switch (orden) {
-		case ORDEN_SWITCH_1_UP:
-		case ORDEN_SWITCH_2_UP:
-		case ORDEN_SWITCH_3_DOWN:
-		case ORDEN_SWITCH_2_DOWN:
-			GPIOA->BSRR = estadoGPIOPorCuadranteYOrden[numCuadrante][estado];
-			break;
-		case ORDEN_SWITCH_3_UP:
-			GPIOA->BSRR = estadoGPIOOn;
-			break;
-		case ORDEN_SWITCH_1_DOWN:
-			GPIOA->BSRR = estadoGPIOOff;
-			break;
-	}
-}
+static RAM_FUNC void GestorSVM_Calculoaceleracioneracion(ContextoSVM* ctx) {
+	uint32_t cambio;
 
-static void GestorSVM_Calculoaceleracioneracion() {
 	/* Sincronización con parámetros sombra, si corresponde */
-	if (flagActualizarParamSombra) {
-		frecObjetivo       = paramSombra.frecObjetivo;
-		cambioFrecuenciaPorCiclo = paramSombra.cambioFrecuenciaPorCiclo;
-		direccionRotacion  = paramSombra.direccionRotacion;
-		flagMotorRunning   = paramSombra.flagMotorRunning;
-		flagEsAcelerado    = paramSombra.flagEsAcelerado;
-		flagChangingFrecuencia   = paramSombra.flagChangingFrecuencia;
-		flagActualizarParamSombra = 0;
-	}
-
-	/* Aplicación de rampa */
-	if (flagEsAcelerado) {
-		frecuenciaSalida += cambioFrecuenciaPorCiclo;
-		if (frecuenciaSalida >= frecObjetivo) {
-			frecuenciaSalida = frecObjetivo;
-			GestorEstados_Action(ACTION_TO_CONST_RUNNING, 0);
-			flagChangingFrecuencia = 0;
+	if (ctx->flagActualizarParamSombra) {
+		ctx->frecObjetivo       = ctx->paramSombra.frecObjetivo;
+		ctx->cambioFrecuenciaPorCiclo = ctx->paramSombra.cambioFrecuenciaPorCiclo;
+		ctx->flagMotorRunning   = ctx->paramSombra.flagMotorRunning;
+		ctx->flagEsAcelerado    = ctx->paramSombra.flagEsAcelerado;
+		ctx->flagChangingFrecuencia   = ctx->paramSombra.flagChangingFrecuencia;
+		ctx->flagActualizarParamSombra = 0;
+	}
+
+	/* Aplicación de rampa. En sincrónico el período no es el nominal y el paso se escala con él */
+	cambio = ctx->cambioFrecuenciaPorCiclo;
+#if SVM_SINCRONO_RELACION_MAXIMA > 0
+	if (ctx->relacionSincrona) {
+		cambio = (uint32_t)(((uint64_t)cambio * ctx->escalaRampaSincrona) >> 16);
+	}
+#endif
+	if (ctx->flagEsAcelerado) {
+		ctx->frecuenciaSalida += cambio;
+		if (ctx->frecuenciaSalida >= ctx->frecObjetivo) {
+			ctx->frecuenciaSalida = ctx->frecObjetivo;
+			if (ctx->puente == 0) {
+				GestorEstados_Action(ACTION_TO_CONST_RUNNING, 0);
+			}
+			ctx->flagChangingFrecuencia = 0;
 		}
 	} else {
-		frecuenciaSalida -= cambioFrecuenciaPorCiclo;
-		if (frecuenciaSalida <= frecObjetivo) {
-			frecuenciaSalida = frecObjetivo;
-
-			if (frecObjetivo == 0) {
-				flagMotorRunning = 0;
-				GestorTimers_DetenerTimerSVM();
-				GestorSVM_SwitchInterrupt(SWITCH_INT_CLEAN);
-
-				/* Limpia buffer productor/consumidor */
-				bufferCalculo.indiceEscritura = 0;
-				bufferCalculo.indiceLectura   = 0;
-				bufferCalculo.contadorDeDatos     = 0;
+		ctx->frecuenciaSalida -= cambio;
+		if (ctx->frecuenciaSalida <= ctx->frecObjetivo) {
+			ctx->frecuenciaSalida = ctx->frecObjetivo;
 
-				/* Apaga salidas y drivers */
-				HAL_GPIO_WritePin(GPIOA, GPIO_U_IN, GPIO_PIN_RESET);
-				HAL_GPIO_WritePin(GPIOA, GPIO_V_IN, GPIO_PIN_RESET);
-				HAL_GPIO_WritePin(GPIOA, GPIO_W_IN, GPIO_PIN_RESET);
-
-				HAL_GPIO_WritePin(GPIOA, GPIO_U_SD, GPIO_PIN_RESET);
-				HAL_GPIO_WritePin(GPIOA, GPIO_V_SD, GPIO_PIN_RESET);
-				HAL_GPIO_WritePin(GPIOA, GPIO_W_SD, GPIO_PIN_RESET);
+			if (ctx->frecObjetivo == 0) {
+				GestorSVM_Apagar(ctx);
 
 				/* Notifica detención */
-				GestorEstados_Action(ACTION_MOTOR_STOPPED, 0);
-			} else {
+				if (ctx->puente == 0) {
+					GestorEstados_Action(ACTION_MOTOR_STOPPED, 0);
+				}
+			} else if (ctx->puente == 0) {
 				GestorEstados_Action(ACTION_TO_CONST_RUNNING, 0);
 			}
-			flagChangingFrecuencia = 0;
+			ctx->flagChangingFrecuencia = 0;
 		}
 	}
 
-	/* Índice de modulación (V/f) */
-	if (frecuenciaSalida < 50 * 1000 * 1000) {
-		indiceModulacion = frecuenciaSalida / (500 * 1000); // lineal hasta 50 Hz
+	GestorSVM_ActualizarIndice(ctx);
+
+	/* Incremento de fase por muestra y por tick de ARR (sin división) */
+	ctx->incrementoFase = (uint32_t)(((uint64_t)ctx->frecuenciaSalida * ctx->constFrecuenciaAIncremento) >> FASE_INCREMENTO_SHIFT);
+	ctx->incrementoFasePorTick = (uint32_t)(((uint64_t)ctx->frecuenciaSalida * CONST_FRECUENCIA_A_INCREMENTO_TICK) >> FASE_INCREMENTO_SHIFT);
+
+#if SVM_SINCRONO_RELACION_MAXIMA > 0
+	GestorSVM_ActualizarSincronismo(ctx);
+#endif
+}
+
+static RAM_FUNC void GestorSVM_ActualizarIndice(ContextoSVM* ctx) {
+	int indice;
+
+	/* Índice de modulación (V/f): 100 a 50 Hz, luego sobremodulación hasta INDICE_MODULACION_MAXIMO */
+#if SVM_VBUS_FUENTE != SVM_VBUS_NINGUNA
+	ctx->versionBus = tensionBus.version;
+	indice = (int)((((uint64_t)(uint32_t)ctx->frecuenciaSalida * tensionBus.escala) >> 16) / (500 * 1000));
+#else
+	indice = ctx->frecuenciaSalida / (500 * 1000);
+#endif
+	if (indice > INDICE_MODULACION_MAXIMO) {
+		indice = INDICE_MODULACION_MAXIMO;
+	}
+	if (indice < 1) {
+		indice = 1;
+	}
+	ctx->indiceModulacion = indice;
+	CalculoSVM_Modulacion(indice, ctx->ticksMedioPeriodo, &ctx->modulacion);
+}
+
+#if SVM_VBUS_FUENTE != SVM_VBUS_NINGUNA
+static RAM_FUNC void GestorSVM_ActualizarBus(void) {
+	uint32_t medicion;
+	uint32_t filtrada;
+	uint32_t escala;
+
+#if SVM_VBUS_FUENTE == SVM_VBUS_ADC
+	/* ADC2 convierte en forma continua: DR siempre tiene la última conversión. Q16 → Q4 */
+	medicion = (ADC2->DR * SVM_VBUS_VOLTIOS_POR_CUENTA_Q16) >> 12;
+#else
+	medicion = tensionBus.medicion;
+#endif
+	if (medicion == 0) {
+		return;
+	}
+
+	/* Primer orden; la primera medición carga el filtro entero para no arrancar desde 0 V */
+	if (tensionBus.acumulador == 0) {
+		tensionBus.acumulador = medicion << SVM_VBUS_FILTRO_SHIFT;
 	} else {
-		indiceModulacion = 100;
+		tensionBus.acumulador += medicion - (tensionBus.acumulador >> SVM_VBUS_FILTRO_SHIFT);
+	}
+	filtrada = tensionBus.acumulador >> SVM_VBUS_FILTRO_SHIFT;
+	if (filtrada == tensionBus.filtrada) {
+		return;
+	}
+	tensionBus.filtrada = filtrada;
+
+	/* Nominal Q20 / filtrada Q4 = escala Q16 */
+	escala = ((uint32_t)SVM_VBUS_NOMINAL << 20) / filtrada;
+	if (escala < SVM_VBUS_ESCALA_MINIMA_Q16) {
+		escala = SVM_VBUS_ESCALA_MINIMA_Q16;
+	} else if (escala > SVM_VBUS_ESCALA_MAXIMA_Q16) {
+		escala = SVM_VBUS_ESCALA_MAXIMA_Q16;
+	}
+	if (escala != tensionBus.escala) {
+		tensionBus.escala = escala;
+		tensionBus.version++;
+	}
+}
+#endif
+
+#if SVM_SINCRONO_RELACION_MAXIMA > 0
+static RAM_FUNC void GestorSVM_ActualizarSincronismo(ContextoSVM* ctx) {
+	int relacion = ctx->relacionSincrona;
+	uint64_t portadora;
+
+	/* Entra con la relación máxima cuando la portadora asincrónica ya no da más muestras por ciclo */
+	if (relacion == 0) {
+		if ((uint64_t)SVM_SINCRONO_RELACION_MAXIMA * (uint32_t)ctx->frecuenciaSalida < ctx->portadoraNominal) {
+			return;
+		}
+		relacion = SVM_SINCRONO_RELACION_MAXIMA;
+	}
+
+	/* N baja si la portadora pasa la ventana, sin bajar de FREC_SWITCH_MINIMA; sube si con N + paso no pasa la nominal */
+	while (relacion > SVM_SINCRONO_RELACION_MINIMA
+			&& (uint64_t)relacion * (uint32_t)ctx->frecuenciaSalida > ctx->portadoraMaxima
+			&& (uint64_t)(relacion - SVM_SINCRONO_RELACION_PASO) * (uint32_t)ctx->frecuenciaSalida >= (uint64_t)FREC_SWITCH_MINIMA * 1000 * 1000) {
+		relacion -= SVM_SINCRONO_RELACION_PASO;
 	}
-	if (indiceModulacion < 1) {
-		indiceModulacion = 1;
+	while (relacion < SVM_SINCRONO_RELACION_MAXIMA
+			&& (uint64_t)(relacion + SVM_SINCRONO_RELACION_PASO) * (uint32_t)ctx->frecuenciaSalida <= ctx->portadoraNominal) {
+		relacion += SVM_SINCRONO_RELACION_PASO;
 	}
 
-	/* Incremento angular por switching (cuidar orden para evitar overflow) */
-	anguloSwitching = (frecuenciaSalida / frecuenciaSwitching) * 360;
+	/* Sale cuando con la relación máxima la portadora cae por debajo de la ventana */
+	portadora = (uint64_t)relacion * (uint32_t)ctx->frecuenciaSalida;
+	if (relacion == SVM_SINCRONO_RELACION_MAXIMA && portadora < ctx->portadoraMinima) {
+		ctx->relacionSincrona = 0;
+		return;
+	}
+
+	if (relacion != ctx->relacionSincrona) {
+		ctx->avanceSincrono = (uint32_t)(((1ULL << 32) + relacion / 2) / relacion);
+	}
+	ctx->ticksSincrono = (int)(((uint64_t)SVM_FREC_TIMER / 2 * 1000 * 1000 + portadora / 2) / portadora);
+	ctx->escalaRampaSincrona = ((uint32_t)ctx->ticksSincrono << 16) / (uint32_t)ctx->ticksPeriodo;
+	CalculoSVM_Modulacion(ctx->indiceModulacion, ctx->ticksSincrono - 1, &ctx->modulacionSincrona);
+	ctx->relacionSincrona = relacion;
 }
+#endif
 
 /**
  * @fn void GestorSVM_SetConfiguration(ConfiguracionSVM* configuracion)
- * @brief Carga la configuración base de SVM y prepara tablas de BSRR por cuadrante.
+ * @brief Carga la configuración base de SVM y elige las tablas de salida del sentido de giro.
  * @param configuracion Puntero a @ref ConfiguracionSVM.
  */
 void GestorSVM_SetConfiguration(ConfiguracionSVM* configuracion) {
-	int i;
+	ContextoSVM* ctx = contextoSeleccionado;
+
 	/* Dinámicos */
-	frecuenciaSwitching       = configuracion->frecuenciaSwitching;
-	direccionRotacion = configuracion->direccionRotacion;
-	aceleracion              = configuracion->aceleracion;
-	desaceleracion           = configuracion->desaceleracion;
+	if (GestorSVM_SetFrecuenciaSwitching(configuracion->frec_switch) != 0) {
+		GestorSVM_SetFrecuenciaSwitching(FREC_SWITCH);
+	}
+	ctx->direccionRotacion = configuracion->direccionRotacion;
+	ctx->tablasSentido            = TABLAS_SENTIDO(ctx->direccionRotacion);
+	ctx->aceleracion              = configuracion->acel;
+	ctx->desaceleracion           = configuracion->desacel;
 
 	/* Referencia (inicia como target) */
-	GestorSVM_SetFrec(configuracion->frecuenciaReferenica);
+	GestorSVM_SetFrec(configuracion->frecReferencia * FREC_RESOLUCION);
+
+#if SVM_PERFIL
+	/* Contador de ciclos del DWT para las mediciones */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
 
 	printf("Configuracion Seteada \n");
-	int estado0, estado1, estado2, estado3;
-	int pinToggle1, pinToggle2, pinToggle3;
-	uint32_t myBSRR;
+}
+
+static RAM_FUNC void GestorSVM_Producir(ContextoSVM* ctx) {
+	MuestraSVM muestra;
+	uint32_t indiceEscritura;
+	uint32_t ocupacion;
+	uint32_t avanceFase;
+	int lote;
+#if SVM_CORRIENTE_SHUNT
+	int desplazamiento[3];
+	int cuadranteSubida;
+#endif
+
+#if SVM_CORRIENTE_SHUNT
+	GestorSVM_ReconstruirCorrientes(ctx);
+#endif
+
+	indiceEscritura = ctx->bufferCalculo.indiceEscritura;
+	ocupacion = indiceEscritura - ctx->bufferCalculo.indiceLectura;
+
+	for (lote = 0; lote < BUFFER_CALCULO_LOTE && ocupacion < BUFFER_CALCULO_SIZE; lote++) {
+		avanceFase = GestorSVM_IniciarPeriodo(ctx);
+
+		/* La rampa llegó a 0 Hz: los timers ya se detuvieron y el buffer se vació */
+		if (!ctx->flagMotorRunning) {
+			return;
+		}
+
+		/* Encolar resultados */
+		muestra.ticksPeriodo = ctx->ticksPeriodoMuestra;
+#if SVM_MUESTREO_DOBLE
+		/* Subida con medio avance de fase y bajada con el resto */
+		GestorSVM_CalcularValoresSwitching(ctx, avanceFase >> 1);
+#if SVM_CORRIENTE_SHUNT
+		GestorSVM_PrepararMuestreo(ctx, &muestra, desplazamiento);
+		cuadranteSubida = ctx->cuadranteActual;
+#endif
+#if SVM_SALIDA == SVM_SALIDA_GPIO_ISR
+		GestorSVM_ArmarFlancos(ctx, &muestra);
+#else
+		GestorSVM_ArmarCCRTIM1(ctx, muestra.ccr);
+#endif
+		GestorSVM_CalcularValoresSwitching(ctx, avanceFase - (avanceFase >> 1));
+#if SVM_CORRIENTE_SHUNT
+		GestorSVM_CompensarVentana(ctx, desplazamiento, cuadranteSubida);
+#endif
+#if SVM_SALIDA == SVM_SALIDA_GPIO_ISR
+		GestorSVM_ArmarFlancosBajada(ctx, &muestra);
+#else
+		GestorSVM_ArmarCCRTIM1(ctx, muestra.ccrBajada);
+#endif
+#else
+		GestorSVM_CalcularValoresSwitching(ctx, avanceFase);
+#if SVM_SALIDA == SVM_SALIDA_GPIO_ISR
+		GestorSVM_ArmarFlancos(ctx, &muestra);
+#elif SVM_SALIDA == SVM_SALIDA_TIM1
+		GestorSVM_ArmarCCRTIM1(ctx, muestra.ccr);
+#endif
+#endif
+		ctx->bufferCalculo.muestra[indiceEscritura & BUFFER_CALCULO_MASK] = muestra;
+
+		/* Publica la muestra: el consumidor solo la ve una vez escrita */
+		indiceEscritura++;
+		ctx->bufferCalculo.indiceEscritura = indiceEscritura;
+		ctx->bufferCalculo.muestrasProducidas++;
+		ocupacion = indiceEscritura - ctx->bufferCalculo.indiceLectura;
+	}
 
-	estadoGPIOOff = (GPIO_U_IN | GPIO_V_IN | GPIO_W_IN) << 16;
-	estadoGPIOOn  = (GPIO_U_IN | GPIO_V_IN | GPIO_W_IN);
+	if (ocupacion > ctx->bufferCalculo.ocupacionMaxima) {
+		ctx->bufferCalculo.ocupacionMaxima = ocupacion;
+	}
+}
 
-	for (i = 0; i < 6; i++) {
-		estado0 = vectorSecuenciaPorCuadrante[i][0];
-		estado1 = vectorSecuenciaPorCuadrante[i][1];
-		estado2 = vectorSecuenciaPorCuadrante[i][2];
-		estado3 = vectorSecuenciaPorCuadrante[i][3];
+/**
+ * @fn void GestorSVM_CalcInterrupt(void)
+ * @brief Handler llamado por el timer de cálculo (productor). Llena el buffer de cada puente en marcha.
+ */
+RAM_FUNC void GestorSVM_CalcInterrupt() {
+	int puente;
+	PERFIL_INICIO();
+
+#if SVM_VBUS_FUENTE != SVM_VBUS_NINGUNA
+	GestorSVM_ActualizarBus();
+#endif
+	for (puente = 0; puente < SVM_CANTIDAD_PUENTES; puente++) {
+		if (contextos[puente].flagMotorRunning) {
+			GestorSVM_Producir(&contextos[puente]);
+		}
+	}
+	PERFIL_FIN(PERFIL_SVM_CALCULO);
+}
 
-		/* Estado 0→1 */
-		myBSRR = 0;
-		myBSRR |= ((estado1 & 0b100) > 0) ? puerto_senal_pierna[0] : (puerto_senal_pierna[0] << 16);
-		myBSRR |= ((estado1 & 0b010) > 0) ? puerto_senal_pierna[1] : (puerto_senal_pierna[1] << 16);
-		myBSRR |= ((estado1 & 0b001) > 0) ? puerto_senal_pierna[2] : (puerto_senal_pierna[2] << 16);
-		estadoGPIOPorCuadranteYOrden[i][0] = myBSRR;
+/**
+ * @fn void GestorSVM_GetEstadisticasBuffer(EstadisticasBufferSVM* estadisticas)
+ * @brief Copia las estadísticas del buffer de cálculo desde el último arranque.
+ */
+void GestorSVM_GetEstadisticasBuffer(EstadisticasBufferSVM* estadisticas) {
+	ContextoSVM* ctx = contextoSeleccionado;
+
+	estadisticas->tamanio            = BUFFER_CALCULO_SIZE;
+	estadisticas->ocupacionMaxima    = ctx->bufferCalculo.ocupacionMaxima;
+	estadisticas->ocupacionMinima    = ctx->bufferCalculo.ocupacionMinima;
+	estadisticas->faltantes          = ctx->bufferCalculo.faltantes;
+	estadisticas->muestrasProducidas = ctx->bufferCalculo.muestrasProducidas;
+}
 
-		/* Estado 1→2 */
-		myBSRR = 0;
-		myBSRR |= ((estado2 & 0b100) > 0) ? puerto_senal_pierna[0] : (puerto_senal_pierna[0] << 16);
-		myBSRR |= ((estado2 & 0b010) > 0) ? puerto_senal_pierna[1] : (puerto_senal_pierna[1] << 16);
-		myBSRR |= ((estado2 & 0b001) > 0) ? puerto_senal_pierna[2] : (puerto_senal_pierna[2] << 16);
-		estadoGPIOPorCuadranteYOrden[i][1] = myBSRR;
+/**
+ * @fn int GestorSVM_GetCorrientes(CorrientesSVM* corrientes)
+ * @brief Copia las corrientes de fase del puente 0 reconstruidas con el shunt.
+ * @return 0 OK; -1 sin períodos reconstruidos o sin @ref SVM_CORRIENTE_SHUNT.
+ */
+int GestorSVM_GetCorrientes(CorrientesSVM* corrientes) {
+#if SVM_CORRIENTE_SHUNT
+	ContextoSVM* ctx = &contextos[0];
+	uint32_t periodos;
+
+	/* El productor tiene más prioridad: si reconstruyó otro período durante la copia, se copia de nuevo */
+	do {
+		periodos = ctx->corrientes.periodos;
+		corrientes->fase[0] = ctx->corrientes.fase[0];
+		corrientes->fase[1] = ctx->corrientes.fase[1];
+		corrientes->fase[2] = ctx->corrientes.fase[2];
+	} while (periodos != ctx->corrientes.periodos);
+	corrientes->periodos = periodos;
+	corrientes->perdidos = ctx->corrientes.perdidos;
+
+	return (periodos > 0) ? 0 : -1;
+#else
+	(void)corrientes;
+	return -1;
+#endif
+}
 
-		/* Pines que conmutan entre estados (XOR) */
-		pinToggle1 = pinMap(estado0 ^ estado1);
-		pinToggle2 = pinMap(estado1 ^ estado2);
-		pinToggle3 = pinMap(estado2 ^ estado3);
+/**
+ * @fn int GestorSVM_GetPerfil(int camino, PerfilSVM* perfil)
+ * @brief Copia la medición de un camino de interrupción desde el último reinicio.
+ * @return 0 OK; -1 camino fuera de rango; -2 sin @ref SVM_PERFIL.
+ */
+int GestorSVM_GetPerfil(int camino, PerfilSVM* perfil) {
+#if SVM_PERFIL
+	volatile AcumuladorPerfil* origen;
+	uint32_t cantidad;
+	uint64_t suma;
+	int i;
 
-		/* Mapa a U/V/W con desplazamiento */
-		pinTogglePorCuadranteYOrden[i][0] = GPIO_U_IN << (pinToggle1 * 2);
-		pinTogglePorCuadranteYOrden[i][1] = GPIO_U_IN << (pinToggle2 * 2);
-		pinTogglePorCuadranteYOrden[i][2] = GPIO_U_IN << (pinToggle3 * 2);
+	if (camino < 0 || camino >= PERFIL_SVM_CANTIDAD) {
+		return -1;
+	}
+	origen = &perfiles[camino];
+
+	/* El camino puede registrar durante la copia (tiene más prioridad): se copia de nuevo si cambió la cantidad */
+	do {
+		cantidad = origen->cantidad;
+		if (origen->generacion != generacionPerfil) {
+			/* Reinicio pedido y todavía sin ejecuciones */
+			cantidad = 0;
+			break;
+		}
+		perfil->minimo = origen->minimo;
+		perfil->maximo = origen->maximo;
+		suma = origen->suma;
+		for (i = 0; i < PERFIL_SVM_CUBETAS; i++) {
+			perfil->histograma[i] = origen->histograma[i];
+		}
+	} while (cantidad != origen->cantidad);
+
+	perfil->cantidad = cantidad;
+	if (cantidad == 0) {
+		perfil->minimo = 0;
+		perfil->maximo = 0;
+		perfil->media = 0;
+		for (i = 0; i < PERFIL_SVM_CUBETAS; i++) {
+			perfil->histograma[i] = 0;
+		}
+	} else {
+		perfil->media = (uint32_t)(suma / cantidad);
 	}
+	return 0;
+#else
+	(void)camino;
+	(void)perfil;
+	return -2;
+#endif
 }
 
 /**
- * @fn void GestorSVM_CalcInterrupt(void)
- * @brief Handler llamado por el timer de cálculo (productor). Encola t1/t2/t3 si hay espacio.
+ * @fn int GestorSVM_ResetPerfil(void)
+ * @brief Pide el reinicio de todos los caminos; cada uno limpia su acumulado en la próxima ejecución.
+ * @return 0 OK; -2 sin @ref SVM_PERFIL.
  */
-void GestorSVM_CalcInterrupt() {
-	int indiceEscritura;
+int GestorSVM_ResetPerfil() {
+#if SVM_PERFIL
+	generacionPerfil++;
+	return 0;
+#else
+	return -2;
+#endif
+}
 
-	if (bufferCalculo.contadorDeDatos < BUFFER_CALCULO_SIZE) {
-		indiceEscritura = bufferCalculo.indiceEscritura;
+#if SVM_CORRIENTE_SHUNT
+/**
+ * @fn void GestorSVM_CorrienteInterrupt(void)
+ * @brief Guarda la conversión del shunt y arma el CC4 de la siguiente (o lo deshabilita hasta el próximo valle).
+ */
+RAM_FUNC void GestorSVM_CorrienteInterrupt() {
+	ContextoSVM* ctx = &contextos[0];
+	int indice = ctx->indiceShunt;
+	PERFIL_INICIO();
 
-		GestorSVM_CalcularValoresSwitching();
+	/* Conversión fuera de un período armado (arranque o parada) */
+	if (indice < 0 || indice > 1) {
+		return;
+	}
 
-		/* Encolar resultados */
-		bufferCalculo.ticksChannel1[indiceEscritura] = ticksChannel[0];
-		bufferCalculo.ticksChannel2[indiceEscritura] = ticksChannel[1];
-		bufferCalculo.ticksChannel3[indiceEscritura] = ticksChannel[2];
-		bufferCalculo.casoInterferencia[indiceEscritura] = casoInterferencia;
-		bufferCalculo.cuadranteActual[indiceEscritura]   = cuadranteActual;
+	ctx->lecturaShunt[indice] = (uint16_t)ADC1->JDR1;
+	ctx->timer->CCR4 = (indice == 0) ? ctx->muestraSwitch.ticksMuestreo[1] : TICKS_DESHABILITAR_CANAL;
+	ctx->indiceShunt = indice + 1;
+	PERFIL_FIN(PERFIL_SVM_CORRIENTE);
+}
+#endif
 
-		bufferCalculo.indiceEscritura = (indiceEscritura + 1) % BUFFER_CALCULO_SIZE;
-		bufferCalculo.contadorDeDatos++;
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+/**
+ * @fn void GestorSVM_DMAInterrupt(int mitad)
+ * @brief Recalcula la mitad del buffer DMA que ya fue consumida.
+ */
+RAM_FUNC void GestorSVM_DMAInterrupt(int mitad) {
+	ContextoSVM* ctx = &contextos[0];
+	int indice;
+	int i;
+	PERFIL_INICIO();
+
+#if SVM_VBUS_FUENTE != SVM_VBUS_NINGUNA
+	GestorSVM_ActualizarBus();
+#endif
+	indice = mitad * (DMA_LARGO_BUFFER / 2);
+	for (i = 0; i < SVM_DMA_PERIODOS_POR_MITAD; i++) {
+		GestorSVM_CalcularValoresSwitching(ctx, GestorSVM_IniciarPeriodo(ctx));
+		GestorSVM_ArmarPeriodoDMA(ctx, &bufferDMABSRR[indice], &bufferDMAARR[indice]);
+		indice += DMA_INTERVALOS_POR_PERIODO;
 	}
+	PERFIL_FIN(PERFIL_SVM_CALCULO);
 }
+#endif
 
 /* ------------------------ API invocada por el Gestor de Estados (SPI) ------------------------ */
 
 /**
  * @fn int GestorSVM_SetFrec(int frec)
- * @brief Solicita nueva frecuencia objetivo (Hz). Inicia rampa si el motor está en marcha.
- * @param frec Frecuencia objetivo [Hz].
+ * @brief Solicita nueva frecuencia objetivo. Inicia rampa si el motor está en marcha.
+ * @param frec Frecuencia objetivo [1/@ref FREC_RESOLUCION Hz].
  * @return 0 si aceptada (motor detenido), 1 si aceptada con rampa en curso; -1 fuera de rango; -2 misma que la actual.
  */
 int GestorSVM_SetFrec(int frec) {
+	ContextoSVM* ctx = contextoSeleccionado;
 	int flagEsAcelerado_local;
 	int32_t cambioFrecuenciaPorCiclo_local;
 	int32_t frecTarget_local;
 	int32_t nuevaFrec;
 
-	if (frec < FERC_OUT_MIN || frec > FERC_OUT_MAX) {
+	if (frec < FERC_OUT_MIN * FREC_RESOLUCION || frec > FERC_OUT_MAX * FREC_RESOLUCION) {
 		return -1;
 	}
-	nuevaFrec = (int32_t)frec * 1000 * 1000;
-	if (frecuenciaSalida == nuevaFrec) {
+	nuevaFrec = (int32_t)frec * (1000 * 1000 / FREC_RESOLUCION);
+	if (ctx->frecuenciaSalida == nuevaFrec) {
 		return -2;
 	}
 
-	if (flagMotorRunning) {
+	if (ctx->flagMotorRunning) {
 		/* Determinar sentido de la rampa */
-		if (frecuenciaSalida < nuevaFrec) {
+		if (ctx->frecuenciaSalida < nuevaFrec) {
 			flagEsAcelerado_local = 1;
-			cambioFrecuenciaPorCiclo_local = (aceleracion * 1000 * 1000) / (frecuenciaSwitching);
+			cambioFrecuenciaPorCiclo_local = (ctx->aceleracion * 1000 * 1000) / (ctx->frecuenciaSwitching);
 		} else {
 			flagEsAcelerado_local = 0;
-			cambioFrecuenciaPorCiclo_local = (desaceleracion * 1000 * 1000) / (frecuenciaSwitching);
+			cambioFrecuenciaPorCiclo_local = (ctx->desaceleracion * 1000 * 1000) / (ctx->frecuenciaSwitching);
 		}
 
 		frecTarget_local = nuevaFrec;
-		frecuenciaReferenica = frec;
+		ctx->frecuenciaReferenica = frec;
 
 		/* Parámetros sombra */
-		paramSombra.flagMotorRunning   = 1;
-		paramSombra.flagChangingFrecuencia   = 1;
-		paramSombra.flagEsAcelerado    = flagEsAcelerado_local;
-		paramSombra.cambioFrecuenciaPorCiclo = cambioFrecuenciaPorCiclo_local;
-		paramSombra.frecObjetivo       = frecTarget_local;
-		flagActualizarParamSombra = 1;
-
-		flagChangingFrecuencia = 1;
+		ctx->paramSombra.flagMotorRunning   = 1;
+		ctx->paramSombra.flagChangingFrecuencia   = 1;
+		ctx->paramSombra.flagEsAcelerado    = flagEsAcelerado_local;
+		ctx->paramSombra.cambioFrecuenciaPorCiclo = cambioFrecuenciaPorCiclo_local;
+		ctx->paramSombra.frecObjetivo       = frecTarget_local;
+		ctx->flagActualizarParamSombra = 1;
+
+		ctx->flagChangingFrecuencia = 1;
 		return 1;
 	} else {
-		frecuenciaReferenica = frec;
+		ctx->frecuenciaReferenica = frec;
 		return 0;
 	}
 }
@@ -715,58 +2041,39 @@ int GestorSVM_SetFrec(int frec) {
  * @return 0 OK; -1 fuera de rango; -2 si motor en marcha o rampa activa.
  */
 int GestorSVM_SetDir(int dir) {
-	int estado1, estado2;
-	int i;
-	uint32_t myBSRR;
+	ContextoSVM* ctx = contextoSeleccionado;
 
-	if (flagMotorRunning) {
+	if (ctx->flagMotorRunning) {
 		return -2;
 	}
-	if (flagChangingFrecuencia) {
+	if (ctx->flagChangingFrecuencia) {
 		return -2;
 	}
 	if (dir != 0 && dir != 1) {
 		return -1;
 	}
-	if (dir == direccionRotacion) {
-		return 0;
-	}
-
-	/* Recalcular tablas BSRR intercambiando U↔V */
-	for (i = 0; i < 6; i++) {
-		estado1 = vectorSecuenciaPorCuadrante[i][1];
-		estado2 = vectorSecuenciaPorCuadrante[i][2];
-
-		myBSRR = 0;
-		myBSRR |= ((estado1 & 0b100) ? GPIO_V_IN : (GPIO_V_IN << 16));
-		myBSRR |= ((estado1 & 0b010) ? GPIO_U_IN : (GPIO_U_IN << 16));
-		myBSRR |= ((estado1 & 0b001) ? GPIO_W_IN : (GPIO_W_IN << 16));
-		estadoGPIOPorCuadranteYOrden[i][0] = myBSRR;
 
-		myBSRR = 0;
-		myBSRR |= ((estado2 & 0b100) ? GPIO_V_IN : (GPIO_V_IN << 16));
-		myBSRR |= ((estado2 & 0b010) ? GPIO_U_IN : (GPIO_U_IN << 16));
-		myBSRR |= ((estado2 & 0b001) ? GPIO_W_IN : (GPIO_W_IN << 16));
-		estadoGPIOPorCuadranteYOrden[i][1] = myBSRR;
-	}
-
-	direccionRotacion = dir;
+	/* Las dos tablas ya están armadas: U↔V es solo cambiar de puntero */
+	ctx->tablasSentido = TABLAS_SENTIDO(dir);
+	ctx->direccionRotacion = dir;
 	return 0;
 }
 
 /**
- * @fn int GestorSVM_Setaceleracion(int nuevaaceleracion)
+ * @fn int GestorSVM_SetAcel(int nuevaaceleracion)
  * @brief Actualiza acelerada [Hz/s].
  * @return 0 OK; -1 fuera de rango; -2 si hay rampa activa.
  */
-int GestorSVM_Setaceleracion(int nuevaaceleracion) {
-	if (flagChangingFrecuencia) {
+int GestorSVM_SetAcel(int nuevaaceleracion) {
+	ContextoSVM* ctx = contextoSeleccionado;
+
+	if (ctx->flagChangingFrecuencia) {
 		return -2;
 	}
 	if (nuevaaceleracion < ACELERACION_MINIMA || nuevaaceleracion > ACCLERACION_MAXIMA) {
 		return -1;
 	}
-	aceleracion = nuevaaceleracion;
+	ctx->aceleracion = nuevaaceleracion;
 	return 0;
 }
 
@@ -776,48 +2083,97 @@ int GestorSVM_Setaceleracion(int nuevaaceleracion) {
  * @return 0 OK; -1 fuera de rango; -2 si hay rampa activa.
  */
 int GestorSVM_SetDecel(int nuevaDecel) {
-	if (flagChangingFrecuencia) {
+	ContextoSVM* ctx = contextoSeleccionado;
+
+	if (ctx->flagChangingFrecuencia) {
 		return -2;
 	}
 	if (nuevaDecel < DESACELERACION_MINIMA || nuevaDecel > DESACELERACION_MAXIMA) {
 		return -1;
 	}
-	desaceleracion = nuevaDecel;
+	ctx->desaceleracion = nuevaDecel;
 	return 0;
 }
 
 /**
  * @fn int GestorSVM_MotorStart(void)
- * @brief Arranca el motor: habilita drivers, inicia timers y rampa hacia @ref frecuenciaReferenica.
+ * @brief Arranca el motor: habilita drivers, inicia timers y rampa hacia @ref ContextoSVM::frecuenciaReferenica.
  * @return 0 si arranca; 1 si ya estaba en marcha.
  */
 int GestorSVM_MotorStart() {
-	if (!flagMotorRunning) {
-		flagMotorRunning = 1;
-		flagEsAcelerado = 1;
-		flagChangingFrecuencia = 1;
+	ContextoSVM* ctx = contextoSeleccionado;
 
-		cambioFrecuenciaPorCiclo = (aceleracion * 1000 * 1000) / (frecuenciaSwitching);
+	if (!ctx->flagMotorRunning) {
+		ctx->flagEsAcelerado = 1;
+		ctx->flagChangingFrecuencia = 1;
+
+		ctx->cambioFrecuenciaPorCiclo = (ctx->aceleracion * 1000 * 1000) / (ctx->frecuenciaSwitching);
 
 		/* Parámetros sombra de arranque */
-		paramSombra.frecObjetivo = (uint32_t)frecuenciaReferenica * 1000 * 1000;
-		paramSombra.flagMotorRunning = 1;
-		paramSombra.flagEsAcelerado = 1;
-		paramSombra.flagChangingFrecuencia = 1;
-		paramSombra.cambioFrecuenciaPorCiclo = cambioFrecuenciaPorCiclo;
-		flagActualizarParamSombra = 1;
+		ctx->paramSombra.frecObjetivo = (uint32_t)ctx->frecuenciaReferenica * (1000 * 1000 / FREC_RESOLUCION);
+		ctx->paramSombra.flagMotorRunning = 1;
+		ctx->paramSombra.flagEsAcelerado = 1;
+		ctx->paramSombra.flagChangingFrecuencia = 1;
+		ctx->paramSombra.cambioFrecuenciaPorCiclo = ctx->cambioFrecuenciaPorCiclo;
+		ctx->flagActualizarParamSombra = 1;
 
 		/* Habilitar drivers */
-		HAL_GPIO_WritePin(GPIOA, GPIO_U_SD, GPIO_PIN_SET);
-		HAL_GPIO_WritePin(GPIOA, GPIO_V_SD, GPIO_PIN_SET);
-		HAL_GPIO_WritePin(GPIOA, GPIO_W_SD, GPIO_PIN_SET);
-
-		/* Precargar una muestra y sincronizar switching */
-		GestorSVM_CalcInterrupt();
-		GestorSVM_SwitchInterrupt(SWITCH_INT_RESET);
+		HAL_GPIO_WritePin(ctx->puerto, PIN_PUENTE(ctx, GPIO_U_SD), GPIO_PIN_SET);
+		HAL_GPIO_WritePin(ctx->puerto, PIN_PUENTE(ctx, GPIO_V_SD), GPIO_PIN_SET);
+		HAL_GPIO_WritePin(ctx->puerto, PIN_PUENTE(ctx, GPIO_W_SD), GPIO_PIN_SET);
+
+		/* Buffer vacío y estadísticas desde este arranque */
+		GestorSVM_VaciarBuffer(ctx);
+
+		/* El modo de PWM se toma de nuevo con la primera muestra */
+		ctx->cuadranteModoPWM = -1;
+
+#if SVM_SINCRONO_RELACION_MAXIMA > 0
+		/* Arranca con portadora asincrónica; la rampa entra al sincrónico si corresponde */
+		ctx->relacionSincrona = 0;
+#endif
+
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+		/* Precargar las dos mitades del buffer e iniciar TIM3 con sus DMA */
+		ctx->flagMotorRunning = 1;
+		GestorSVM_DMAInterrupt(0);
+		GestorSVM_DMAInterrupt(1);
+		GestorTimers_IniciarTimerSVMDMA(bufferDMABSRR, bufferDMAARR, DMA_LARGO_BUFFER);
+#elif SVM_SALIDA == SVM_SALIDA_TIM1
+		/* Precargar una muestra en los CCR de TIM1 e iniciar el PWM */
+		ctx->flagMotorRunning = 1;
+		GestorSVM_Producir(ctx);
+		GestorSVM_ActualizarTIM1(ctx);
+		GestorTimers_IniciarTimerSVM(ctx->puente);
+#else
+		if (ctx->timer->CR1 & TIM_CR1_CEN) {
+			/* Otro puente ya usa los timers: TIM2 produce las muestras y el primer valle las toma. Hasta entonces
+			 * se repite un período apagado */
+			ctx->muestraSwitch.ticksPeriodo = ctx->ticksPeriodo;
+			ctx->muestraSwitch.palabraValle = estadoGPIOOff << ctx->desplazamientoPines;
+			ctx->muestraSwitch.cantidadFlancos = 0;
+#if SVM_MUESTREO_DOBLE
+			ctx->muestraSwitch.palabraPico = ctx->muestraSwitch.palabraValle;
+			ctx->muestraSwitch.flancosSubida = 0;
+#endif
+			ctx->flagMotorRunning = 1;
+		} else {
+#if SVM_CORRIENTE_SHUNT
+			/* Sin período armado hasta el primer RESET; las corrientes se cuentan desde este arranque */
+			ctx->indiceShunt = -1;
+			ctx->flagLecturaCompleta = 0;
+			ctx->corrientes.periodos = 0;
+			ctx->corrientes.perdidos = 0;
+#endif
+			/* Precargar una muestra y sincronizar switching */
+			ctx->flagMotorRunning = 1;
+			GestorSVM_Producir(ctx);
+			GestorSVM_SwitchInterrupt(ctx, SWITCH_INT_RESET);
+		}
 
 		/* Iniciar timer de switching */
-		GestorTimers_IniciarTimerSVM();
+		GestorTimers_IniciarTimerSVM(ctx->puente);
+#endif
 		return 0;
 	}
 	return 1;
@@ -825,24 +2181,26 @@ int GestorSVM_MotorStart() {
 
 /**
  * @fn int GestorSVM_MotorStop(void)
- * @brief Ordena frenado con rampa de @ref desaceleracion hasta 0 Hz.
+ * @brief Ordena frenado con rampa de @ref ContextoSVM::desaceleracion hasta 0 Hz.
  * @return 0 si acepta; 1 si ya estaba detenido.
  */
 int GestorSVM_MotorStop() {
-	if (flagMotorRunning) {
-		flagEsAcelerado = 0;
-		flagChangingFrecuencia = 1;
+	ContextoSVM* ctx = contextoSeleccionado;
 
-		cambioFrecuenciaPorCiclo = (desaceleracion * 1000 * 1000) / (frecuenciaSwitching);
-		frecObjetivo = 0;
+	if (ctx->flagMotorRunning) {
+		ctx->flagEsAcelerado = 0;
+		ctx->flagChangingFrecuencia = 1;
+
+		ctx->cambioFrecuenciaPorCiclo = (ctx->desaceleracion * 1000 * 1000) / (ctx->frecuenciaSwitching);
+		ctx->frecObjetivo = 0;
 
 		/* Parámetros sombra */
-		paramSombra.flagMotorRunning = 1;
-		paramSombra.flagEsAcelerado = 0;
-		paramSombra.flagChangingFrecuencia = 1;
-		paramSombra.cambioFrecuenciaPorCiclo = cambioFrecuenciaPorCiclo;
-		paramSombra.frecObjetivo = 0;
-		flagActualizarParamSombra = 1;
+		ctx->paramSombra.flagMotorRunning = 1;
+		ctx->paramSombra.flagEsAcelerado = 0;
+		ctx->paramSombra.flagChangingFrecuencia = 1;
+		ctx->paramSombra.cambioFrecuenciaPorCiclo = ctx->cambioFrecuenciaPorCiclo;
+		ctx->paramSombra.frecObjetivo = 0;
+		ctx->flagActualizarParamSombra = 1;
 
 		return 0;
 	}
@@ -851,89 +2209,268 @@ int GestorSVM_MotorStop() {
 
 /**
  * @fn int GestorSVM_Estop(void)
- * @brief Parada de emergencia inmediata: desactiva timers, apaga drivers y salidas.
+ * @brief Parada de emergencia inmediata de todos los puentes: desactiva timers, apaga drivers y salidas.
  * @return Siempre 0.
  */
 int GestorSVM_Estop() {
-	if (flagMotorRunning) {
-		GestorTimers_DetenerTimerSVM();
+	ContextoSVM* ctx;
+	int puente;
+
+	for (puente = 0; puente < SVM_CANTIDAD_PUENTES; puente++) {
+		ctx = &contextos[puente];
+		if (ctx->flagMotorRunning) {
+			GestorSVM_Apagar(ctx);
+			ctx->flagChangingFrecuencia = 0;
+			ctx->frecuenciaSalida = 0;
+		}
+	}
+	return 0;
+}
+
+/**
+ * @fn int GestorSVM_SetFrecuenciaSwitching(int frec)
+ * @brief Recalcula ARR, incremento de fase y timers para una nueva frecuencia de switching.
+ * @return 0 OK; -1 fuera de rango; -2 si motor en marcha o rampa activa.
+ */
+int GestorSVM_SetFrecuenciaSwitching(int frec) {
+	ContextoSVM* ctx = contextoSeleccionado;
+
+	if (ctx->flagMotorRunning || ctx->flagChangingFrecuencia) {
+		return -2;
+	}
+	if (frec < FREC_SWITCH_MINIMA || frec > FREC_SWITCH_MAXIMA) {
+		return -1;
+	}
+
+	/* Center-aligned: el contador sube y baja ticksPeriodo por período */
+	ctx->ticksPeriodo = (SVM_FREC_TIMER / 2 + frec / 2) / frec;
+	ctx->ticksMedioPeriodo = ctx->ticksPeriodo - 1;
+	ctx->dispersionTicks = (ctx->ticksPeriodo * ctx->dispersionPorcentaje) / 100;
+	ctx->frecuenciaSwitching = (SVM_FREC_TIMER / 2 + ctx->ticksPeriodo / 2) / ctx->ticksPeriodo;
+	ctx->constFrecuenciaAIncremento = (uint32_t)((1ULL << (32 + FASE_INCREMENTO_SHIFT)) / ((uint64_t)ctx->frecuenciaSwitching * 1000 * 1000));
+
+	/* La ganancia depende de los ticks del período */
+	CalculoSVM_Modulacion(ctx->indiceModulacion, ctx->ticksMedioPeriodo, &ctx->modulacion);
+
+#if SVM_SINCRONO_RELACION_MAXIMA > 0
+	ctx->portadoraNominal = (uint64_t)ctx->frecuenciaSwitching * 1000 * 1000;
+	ctx->portadoraMaxima = ctx->portadoraNominal + (ctx->portadoraNominal >> SVM_SINCRONO_VENTANA_SHIFT);
+	ctx->portadoraMinima = ctx->portadoraNominal - (ctx->portadoraNominal >> SVM_SINCRONO_VENTANA_SHIFT);
+#endif
+
+	GestorTimers_ConfigurarPeriodo(ctx->puente, ctx->ticksPeriodo);
+	return 0;
+}
 
-		HAL_GPIO_WritePin(GPIOA, GPIO_U_SD, GPIO_PIN_RESET);
-		HAL_GPIO_WritePin(GPIOA, GPIO_V_SD, GPIO_PIN_RESET);
-		HAL_GPIO_WritePin(GPIOA, GPIO_W_SD, GPIO_PIN_RESET);
+/** @brief Devuelve la frecuencia de switching efectiva [Hz]. */
+int GestorSVM_GetFrecuenciaSwitching() {
+	return contextoSeleccionado->frecuenciaSwitching;
+}
+
+/**
+ * @fn int GestorSVM_SetModoPWM(int modo)
+ * @brief Selecciona el modo de PWM. Lo toma el productor al entrar en el sector siguiente.
+ * @return 0 OK; -1 fuera de rango.
+ */
+int GestorSVM_SetModoPWM(int modo) {
+	ContextoSVM* ctx = contextoSeleccionado;
+
+	if (modo < MODO_PWM_SVPWM || modo >= MODO_PWM_CANTIDAD) {
+		return -1;
+	}
+	ctx->modoPWM = (ModoPWM)modo;
+	return 0;
+}
+
+/** @brief Devuelve el modo de PWM actual (@ref ModoPWM). */
+int GestorSVM_GetModoPWM() {
+	return contextoSeleccionado->modoPWM;
+}
+
+/**
+ * @fn int GestorSVM_SetModulador(int tipo)
+ * @brief Selecciona el modulador. Lo toma el productor en la próxima muestra.
+ * @return 0 OK; -1 fuera de rango.
+ */
+int GestorSVM_SetModulador(int tipo) {
+	ContextoSVM* ctx = contextoSeleccionado;
+
+	if (tipo < MODULADOR_SVPWM || tipo >= MODULADOR_CANTIDAD) {
+		return -1;
+	}
+	ctx->tipoModulador = (TipoModulador)tipo;
+	return 0;
+}
+
+/** @brief Devuelve el modulador actual (@ref TipoModulador). */
+int GestorSVM_GetModulador() {
+	return contextoSeleccionado->tipoModulador;
+}
+
+/**
+ * @fn int GestorSVM_SetTiempoMuerto(int nuevoTiempoMuerto, int nuevoDesfase)
+ * @brief Configura la compensación de tiempo muerto (ver @ref GestorSVM_CompensarTiempoMuerto).
+ * @return 0 OK; -1 fuera de rango.
+ */
+int GestorSVM_SetTiempoMuerto(int nuevoTiempoMuerto, int nuevoDesfase) {
+	ContextoSVM* ctx = contextoSeleccionado;
 
-		GestorSVM_SwitchInterrupt(SWITCH_INT_CLEAN);
+	if (nuevoTiempoMuerto < 0 || nuevoTiempoMuerto > 1000 * 256) {
+		return -1;
+	}
+	if (nuevoDesfase < 0 || nuevoDesfase > 90) {
+		return -1;
+	}
+	ctx->desfaseCorriente = (uint32_t)nuevoDesfase * (FASE_30_GRADOS / 30);
+	ctx->tiempoMuertoQ8 = nuevoTiempoMuerto;
+	return 0;
+}
+
+/**
+ * @fn int GestorSVM_SetDispersionPortadora(int porcentaje)
+ * @brief Configura la portadora aleatoria (ver @ref GestorSVM_SortearPeriodo).
+ * @return 0 OK; -1 fuera de rango.
+ */
+int GestorSVM_SetDispersionPortadora(int porcentaje) {
+	ContextoSVM* ctx = contextoSeleccionado;
 
-		bufferCalculo.indiceEscritura = 0;
-		bufferCalculo.indiceLectura   = 0;
-		bufferCalculo.contadorDeDatos     = 0;
+	if (porcentaje < 0 || porcentaje > DISPERSION_PORTADORA_MAXIMA) {
+		return -1;
+	}
+	ctx->dispersionPorcentaje = porcentaje;
+	ctx->dispersionTicks = (ctx->ticksPeriodo * porcentaje) / 100;
+	return 0;
+}
 
-		HAL_GPIO_WritePin(GPIOA, GPIO_U_IN, GPIO_PIN_RESET);
-		HAL_GPIO_WritePin(GPIOA, GPIO_V_IN, GPIO_PIN_RESET);
-		HAL_GPIO_WritePin(GPIOA, GPIO_W_IN, GPIO_PIN_RESET);
+/** @brief Devuelve la dispersión de la portadora [%]. */
+int GestorSVM_GetDispersionPortadora() {
+	return contextoSeleccionado->dispersionPorcentaje;
+}
 
-		flagChangingFrecuencia = 0;
-		flagMotorRunning = 0;
-		frecuenciaSalida = 0;
+/**
+ * @fn int GestorSVM_SetTensionBus(int tension)
+ * @brief Carga la tensión del bus recibida del ESP32. El productor la filtra en su próxima interrupción.
+ * @return 0 OK; -1 fuera de rango; -2 sin @ref SVM_VBUS_SPI.
+ */
+int GestorSVM_SetTensionBus(int tension) {
+#if SVM_VBUS_FUENTE == SVM_VBUS_SPI
+	if (tension < 1 || tension > 2 * SVM_VBUS_NOMINAL) {
+		return -1;
 	}
+	tensionBus.medicion = (uint32_t)tension << 4;
+	return 0;
+#else
+	(void)tension;
+	return -2;
+#endif
+}
+
+/** @brief Devuelve la tensión del bus filtrada [V] (0 sin medición). */
+int GestorSVM_GetTensionBus() {
+#if SVM_VBUS_FUENTE != SVM_VBUS_NINGUNA
+	return (int)((tensionBus.acumulador >> SVM_VBUS_FILTRO_SHIFT) + 8) >> 4;
+#else
 	return 0;
+#endif
 }
 
 /**
  * @fn int GestorSVM_GetFrec(void)
- * @brief Devuelve la frecuencia de referencia configurada (Hz).
- * @return @ref frecuenciaReferenica.
+ * @brief Devuelve la frecuencia de referencia configurada [1/@ref FREC_RESOLUCION Hz].
+ * @return @ref ContextoSVM::frecuenciaReferenica.
  */
 int GestorSVM_GetFrec() {
-	return frecuenciaReferenica;
+	return contextoSeleccionado->frecuenciaReferenica;
 }
 
 /** @brief Devuelve acelerada actual [Hz/s]. */
-int GestorSVM_Getaceleracion() {
-	return aceleracion; 
+int GestorSVM_GetAcel() {
+	return contextoSeleccionado->aceleracion;
 }
 
 /** @brief Devuelve desacelerada actual [Hz/s]. */
-int GestorSVM_GetDesaceleracion() {
-	return desaceleracion; 
+int GestorSVM_GetDesacel() {
+	return contextoSeleccionado->desaceleracion;
 }
 
 /** @brief Devuelve sentido de giro (1 horario, -1 antihorario). */
 int GestorSVM_GetDir() {
-	return direccionRotacion; 
+	return contextoSeleccionado->direccionRotacion;
+}
+
+/**
+ * @fn int GestorSVM_SeleccionarPuente(int puente)
+ * @brief Elige el puente sobre el que actúan las funciones de configuración y marcha.
+ * @return 0 OK; -1 fuera de rango.
+ */
+int GestorSVM_SeleccionarPuente(int puente) {
+	if (puente < 0 || puente >= SVM_CANTIDAD_PUENTES) {
+		return -1;
+	}
+	contextoSeleccionado = &contextos[puente];
+	return 0;
+}
+
+/** @brief Devuelve el puente seleccionado. */
+int GestorSVM_GetPuente() {
+	return contextoSeleccionado->puente;
 }
 
-/* ================================ ISR de TIM3 (HAL) ================================ */
+/* ================================ ISR del timer de switching ================================ */
 
 /**
- * @fn void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
- * @brief Callback HAL de Output Compare: enruta eventos CCR de TIM3 a @ref GestorSVM_SwitchInterrupt.
- * @param htim Puntero al handle del timer que disparó el evento.
+ * @fn void GestorSVM_SwitchTimerInterrupt(int puente)
+ * @brief Atiende la IRQ del timer de switching de un puente leyendo SR una sola vez, sin el despacho de HAL_TIM_IRQHandler.
  * @details
- *   - CH1 → @ref SWITCH_INT_RESET
- *   - CH2 → @ref SWITCH_INT_CH1
- *   - CH3 → @ref SWITCH_INT_CH2
- *   - CH4 → @ref SWITCH_INT_CH3
+ *   - @ref SVM_SALIDA_GPIO_ISR (TIM3, TIM4 para el puente 1): CC2 → @ref SWITCH_INT_FLANCO, CC3 → @ref SWITCH_INT_PICO (con
+ *     @ref SVM_MUESTREO_DOBLE), CC1 → @ref SWITCH_INT_RESET. Si llegan juntos se atiende primero el flanco, que es
+ *     anterior al límite.
+ *   - @ref SVM_SALIDA_TIM1 (TIM1_UP): update → @ref GestorSVM_ActualizarTIM1. Con @ref SVM_MUESTREO_DOBLE el update del
+ *     pico (contando hacia abajo) carga la muestra siguiente y el del valle, @ref GestorSVM_ActualizarTIM1Bajada.
+ *   - Los flags se limpian escribiendo 0 solo en los atendidos (rc_w0), antes de despachar.
  */
-void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim) {
-	if (htim->Instance != TIM3) {
-		return;
+RAM_FUNC void GestorSVM_SwitchTimerInterrupt(int puente) {
+	ContextoSVM* ctx = &contextos[puente];
+#if SVM_SALIDA == SVM_SALIDA_GPIO_ISR
+	uint32_t flags = ctx->timer->SR & ctx->timer->DIER & (TIM_SR_CC1IF | TIM_SR_CC2IF | TIM_SR_CC3IF);
+
+	ctx->timer->SR = ~flags;
+	if (flags & TIM_SR_CC2IF) {
+		PERFIL_INICIO();
+		GestorSVM_SwitchInterrupt(ctx, SWITCH_INT_FLANCO);
+		PERFIL_FIN(PERFIL_SVM_FLANCO);
 	}
-
-	switch (htim->Channel) {
-		case HAL_TIM_ACTIVE_CHANNEL_1:
-			GestorSVM_SwitchInterrupt(SWITCH_INT_RESET);
-			break;
-		case HAL_TIM_ACTIVE_CHANNEL_2:
-			GestorSVM_SwitchInterrupt(SWITCH_INT_CH1);
-			break;
-		case HAL_TIM_ACTIVE_CHANNEL_3:
-			GestorSVM_SwitchInterrupt(SWITCH_INT_CH2);
-			break;
-		case HAL_TIM_ACTIVE_CHANNEL_4:
-			GestorSVM_SwitchInterrupt(SWITCH_INT_CH3);
-			break;
-		default:
-			break;
+#if SVM_MUESTREO_DOBLE
+	if (flags & TIM_SR_CC3IF) {
+		PERFIL_INICIO();
+		GestorSVM_SwitchInterrupt(ctx, SWITCH_INT_PICO);
+		PERFIL_FIN(PERFIL_SVM_PICO);
+	}
+#endif
+	if (flags & TIM_SR_CC1IF) {
+		PERFIL_INICIO();
+		GestorSVM_SwitchInterrupt(ctx, SWITCH_INT_RESET);
+		PERFIL_FIN(PERFIL_SVM_RESET);
+	}
+#elif SVM_SALIDA == SVM_SALIDA_TIM1
+	if (ctx->timer->SR & TIM_SR_UIF) {
+		PERFIL_INICIO();
+
+		ctx->timer->SR = ~TIM_SR_UIF;
+#if SVM_MUESTREO_DOBLE
+		if (!(ctx->timer->CR1 & TIM_CR1_DIR)) {
+			GestorSVM_ActualizarTIM1Bajada(ctx);
+			PERFIL_FIN(PERFIL_SVM_RESET);
+			return;
+		}
+		GestorSVM_ActualizarTIM1(ctx);
+		PERFIL_FIN(PERFIL_SVM_PICO);
+#else
+		GestorSVM_ActualizarTIM1(ctx);
+		PERFIL_FIN(PERFIL_SVM_RESET);
+#endif
 	}
+#else
+	(void)ctx;
+#endif
 }
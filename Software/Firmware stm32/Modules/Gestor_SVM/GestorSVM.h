@@ -1,6 +1,8 @@
 #ifndef GESTOR_SVM_GESTORSVM_H_
 #define GESTOR_SVM_GESTORSVM_H_
 
+#include <stdint.h>
+
 /**
  * @struct ValoresSwitching
  * @brief Estructura de trabajo del ISR del timer de switching.
@@ -37,52 +39,470 @@ typedef struct ConfiguracionSVM {
 } ConfiguracionSVM;
 
 /**
- * @enum OrdenSwitch
- * @brief Ordenes simbólicas de conmutación por canal/flujo (UP/DOWN).
- * @details
- *   Mapear a eventos CCR (t1/t2/t3) y flancos (subida/bajada) facilita
- *   el código del ISR. El orden debe coincidir con la secuencia SVM configurada.
+ * @struct EstadisticasBufferSVM
+ * @brief Estadísticas del buffer de cálculo (productor: timer de cálculo; consumidor: timer de switching).
+ * @details Se reinician en cada @ref GestorSVM_MotorStart. Un valor de @ref faltantes distinto de cero indica
+ *          que el timer de switching repitió un período o perdió flancos porque el cálculo llegó tarde.
+ */
+typedef struct EstadisticasBufferSVM {
+    uint32_t tamanio;            /// Tamaño del buffer [muestras].
+    uint32_t ocupacionMaxima;    /// Máximo de muestras encoladas visto por el productor.
+    uint32_t ocupacionMinima;    /// Mínimo de muestras disponibles visto por el consumidor antes de leer.
+    uint32_t faltantes;          /// Veces que el consumidor encontró el buffer vacío.
+    uint32_t muestrasProducidas; /// Muestras calculadas por el productor.
+} EstadisticasBufferSVM;
+
+/**
+ * @struct CorrientesSVM
+ * @brief Corrientes de fase reconstruidas con el shunt del bus (@ref SVM_CORRIENTE_SHUNT).
+ * @details Dos fases salen de las conversiones del período y la tercera de que la suma es cero. Los contadores se
+ *          reinician en cada @ref GestorSVM_MotorStart.
+ */
+typedef struct CorrientesSVM {
+    int32_t fase[3];             /// Corriente de las fases U/V/W [mA], positiva saliente del puente.
+    uint32_t periodos;           /// Períodos reconstruidos (con las dos conversiones).
+    uint32_t perdidos;           /// Períodos en los que faltó alguna conversión.
+} CorrientesSVM;
+
+/**
+ * @enum CaminoPerfilSVM
+ * @brief Caminos de interrupción que mide @ref SVM_PERFIL.
+ * @details Los caminos del timer de switching se nombran por el evento de la portadora, con cualquier salida. Con dos
+ *          puentes, TIM4 suma en los mismos caminos que TIM3.
  */
 typedef enum {
-    ORDEN_SWITCH_1_UP   = 0, /** Evento t1 en flanco de subida.  */
-    ORDEN_SWITCH_2_UP   = 1, /** Evento t2 en flanco de subida.  */
-    ORDEN_SWITCH_3_UP   = 2, /** Evento t3 en flanco de subida.  */
-    ORDEN_SWITCH_3_DOWN = 3, /** Evento t3 en flanco de bajada.  */
-    ORDEN_SWITCH_2_DOWN = 4, /** Evento t2 en flanco de bajada.  */
-    ORDEN_SWITCH_1_DOWN = 5, /** Evento t1 en flanco de bajada.  */
-} OrdenSwitch;
+    PERFIL_SVM_RESET = 0,  /// Valle de la portadora: CC1 de TIM3, o update de TIM1 en el valle.
+    PERFIL_SVM_FLANCO,     /// CC2 de TIM3: un flanco de la tabla (solo @ref SVM_SALIDA_GPIO_ISR).
+    PERFIL_SVM_PICO,       /// Pico de la portadora (@ref SVM_MUESTREO_DOBLE): CC3 de TIM3, o update de TIM1 en el pico.
+    PERFIL_SVM_CALCULO,    /// Productor: TIM2 para todos los puentes, o media transferencia del DMA con @ref SVM_SALIDA_GPIO_DMA.
+    PERFIL_SVM_CORRIENTE,  /// Fin de conversión del shunt (@ref SVM_CORRIENTE_SHUNT).
+    PERFIL_SVM_CANTIDAD    /// Cantidad de caminos (no es un camino).
+} CaminoPerfilSVM;
+
+/** @brief Cubetas del histograma de @ref PerfilSVM: una por potencia de 2 de ciclos. */
+#define PERFIL_SVM_CUBETAS              16
+
+/**
+ * @struct PerfilSVM
+ * @brief Duración de un camino de interrupción en ciclos de CPU (@ref SVM_PERFIL), desde el último
+ *        @ref GestorSVM_ResetPerfil.
+ * @details Se mide el cuerpo del handler con DWT->CYCCNT: no incluye la entrada a la interrupción (12 ciclos en
+ *          Cortex-M3) y sí las interrupciones de más prioridad que lo interrumpan.
+ */
+typedef struct PerfilSVM {
+    uint32_t cantidad;           /// Ejecuciones medidas.
+    uint32_t minimo;             /// Menor duración [ciclos] (0 sin ejecuciones).
+    uint32_t maximo;             /// Mayor duración [ciclos].
+    uint32_t media;              /// Duración media [ciclos].
+    uint32_t histograma[PERFIL_SVM_CUBETAS]; /// Cubeta k: de 2^k a 2^(k+1) - 1 ciclos. La 0 incluye 0 y la última, todo lo mayor.
+} PerfilSVM;
 
 /**
  * @enum SwitchInterruptType
- * @brief Fuentes de interrupción de switching usadas por el ISR.
+ * @brief Fuentes de interrupción de switching usadas por el ISR (@ref SVM_SALIDA_GPIO_ISR).
  * @details
- *   - CH1..CH3: comparaciones CCR activas.
- *   - RESET: sincroniza y precarga nuevos ticks (cambio de sector).
- *   - CLEAN: limpia flags/estado (p.ej. al detener motor).
+ *   - FLANCO: CCR2, siguiente flanco de la tabla del período.
+ *   - RESET: CCR1 en el valle, carga la tabla del período siguiente.
+ *   - PICO: CCR3 en el pico, pasa a los flancos de bajada (solo con @ref SVM_MUESTREO_DOBLE).
+ *   - CLEAN: descarta la tabla (p.ej. al detener motor).
  */
 typedef enum {
-    SWITCH_INT_CH1 = 0,  /// Interrupción por CCR de t1.
-    SWITCH_INT_CH2,      /// Interrupción por CCR de t2.
-    SWITCH_INT_CH3,      /// Interrupción por CCR de t3.
-    SWITCH_INT_RESET,    /// Re-armado de ticks/sincronización por ciclo.
-    SWITCH_INT_CLEAN,    /// Limpieza de estado/flags de switching.
+    SWITCH_INT_FLANCO = 0, /// Interrupción por CCR2: flanco de la tabla.
+    SWITCH_INT_RESET,      /// Carga de la tabla del período en el valle.
+    SWITCH_INT_PICO,       /// Carga de la mitad de bajada en el pico.
+    SWITCH_INT_CLEAN,      /// Limpieza de estado de switching.
 } SwitchInterruptType;
 
+/**
+ * @enum ModoPWM
+ * @brief Reparto del tiempo nulo entre V0 y V7 en cada período de switching.
+ * @details
+ *   Los modos discontinuos usan un solo vector nulo por período (secuencia de cinco segmentos
+ *   V1→V2→V7→V2→V1 o V0→V1→V2→V1→V0): una pierna queda fija al riel y no conmuta, lo que
+ *   reduce un tercio las conmutaciones a igual frecuencia de switching. Los cuadrantes se numeran 0..5.
+ *   @ref MODO_PWM_HIBRIDO elige solo entre SVPWM y @ref SVM_HIBRIDO_MODO_DISCONTINUO según el punto de operación.
+ * @warning Con drivers bootstrap, la pierna fija en alto no recarga su capacitor: DPWM0/1/2 la mantienen
+ *          60° seguidos. DPWMMIN solo fija en bajo.
+ */
+typedef enum {
+    MODO_PWM_SVPWM = 0,  /// Continuo, siete segmentos: t0 en V0 y t0 en V7.
+    MODO_PWM_DPWM0,      /// 60°: cuadrantes pares solo V0, impares solo V7 (fija la fase 30° antes de su pico).
+    MODO_PWM_DPWM1,      /// 60°: fija la fase de mayor tensión, ±30° alrededor de su pico.
+    MODO_PWM_DPWM2,      /// 60°: cuadrantes pares solo V7, impares solo V0 (fija la fase 30° después de su pico).
+    MODO_PWM_DPWMMIN,    /// 120°: solo V0, cada pierna queda en bajo un tercio del período.
+    MODO_PWM_HIBRIDO,    /// SVPWM a baja velocidad (menos ripple) y discontinuo con índice alto (menos pérdidas), con histéresis.
+    MODO_PWM_CANTIDAD    /// Cantidad de modos (no es un modo).
+} ModoPWM;
+
 /* -------------------- Parámetros de operación por defecto / límites -------------------- */
 
 #define FREC_SWITCH                     2511        /// Frecuencia por defecto del switching SVM [Hz].
+#define FREC_SWITCH_MINIMA              1500        /// Frecuencia mínima de switching [Hz]. Con menos, la ganancia Q16 de sobremodulación no entra en 32 bits.
+#define FREC_SWITCH_MAXIMA              20000       /// Frecuencia máxima de switching [Hz].
+#define SVM_FREC_TIMER                  72000000    /// Reloj de los timers de switching y cálculo, sin prescaler [Hz]. Un tick = 13.9 ns.
 #define FREC_REFERENCIA                 50          /// Frecuencia de referencia por defecto [Hz].
 #define DIRECCION_ROTACION              1           /// Sentido de giro por defecto: horario.
-#define RESOLUCION_TIMER                255         /// Resolución (ARR efectivo ~ 255 → 8 bits).
 #define ACCELERACION_DEFAUL             5           /// Aceleración por defecto [Hz/seg].
 
 #define FERC_OUT_MIN                    1           /// Frecuencia mínima permitida [Hz].
-#define FERC_OUT_MAX                    150         /// Frecuencia máxima permitida [Hz].
+#define FREC_RESOLUCION                 100         /// Unidades de la consigna de frecuencia por Hz: @ref GestorSVM_SetFrec recibe centésimas de Hz.
+#define FERC_OUT_MAX                    400         /// Frecuencia máxima permitida [Hz]. Por encima de unos 70 Hz la portadora es sincrónica (@ref SVM_SINCRONO_RELACION_MAXIMA).
 #define DESACELERACION_DEFAULT          3           /// Desaceleración por defecto [Hz/seg].
 #define ACCLERACION_MAXIMA              50          /// Aceleración máxima permitida [Hz/seg].
 #define ACELERACION_MINIMA              1           /// Aceleración mínima permitida [Hz/seg].
 #define DESACELERACION_MAXIMA           50          /// Desaceleración máxima permitida [Hz/seg].
 #define DESACELERACION_MINIMA           1           /// Desaceleración mínima permitida [Hz/seg].
+#define MODO_PWM_DEFAULT                MODO_PWM_HIBRIDO /// Modo de PWM al iniciar (@ref ModoPWM).
+#define MODULADOR_DEFAULT               MODULADOR_SVPWM /// Modulador al iniciar (@ref TipoModulador).
+#define INDICE_MODULACION_MAXIMO        116         /// Índice de modulación máximo: 100 = lineal a 50 Hz, 104 fin de la región lineal, 116 seis pasos.
+#define DISPERSION_PORTADORA_DEFAULT    0           /// Dispersión de la portadora por defecto [% del período]. 0 = portadora fija.
+#define DISPERSION_PORTADORA_MAXIMA     20          /// Dispersión máxima de la portadora [% del período].
+
+/* -------------------- Selección de la salida del SVM (en compilación) -------------------- */
+
+/** @name Salidas del SVM
+ *  @brief Valores posibles de @ref SVM_SALIDA.
+ *  @{ */
+#define SVM_SALIDA_GPIO_ISR             0           /// GPIO conmutado desde las interrupciones CCR de TIM3 (una interrupción por flanco).
+#define SVM_SALIDA_GPIO_DMA             1           /// GPIO escrito por DMA: TIM3 cuenta intervalos y el DMA carga BSRR y ARR de una secuencia precalculada.
+#define SVM_SALIDA_TIM1                 2           /// PWM complementario de TIM1 con tiempo muerto por hardware: solo se cargan los CCR una vez por período.
+/** @} */
+
+/**
+ * @def SVM_SALIDA
+ * @brief Salida utilizada por el SVM. Se puede definir desde las opciones del compilador.
+ */
+#ifndef SVM_SALIDA
+#define SVM_SALIDA                      SVM_SALIDA_GPIO_ISR
+#endif
+
+/**
+ * @def SVM_DMA_PERIODOS_POR_MITAD
+ * @brief Períodos de switching que se calculan en cada mitad del buffer DMA (solo @ref SVM_SALIDA_GPIO_DMA).
+ * @details La CPU interviene una vez por mitad: a mayor valor, menos interrupciones y más latencia ante cambios de consigna.
+ */
+#define SVM_DMA_PERIODOS_POR_MITAD      2
+
+/**
+ * @def SVM_DMA_MIN_TICKS
+ * @brief Duración mínima de un intervalo del DMA [ticks] (solo @ref SVM_SALIDA_GPIO_DMA).
+ * @details El DMA de ARR se dispara con CCR3 = 1 y debe escribir el ARR antes del fin del intervalo: 112 ticks = 1.6 µs,
+ *          el mismo tiempo que los 2 ticks con prescaler 55.
+ */
+#define SVM_DMA_MIN_TICKS               112
+
+/**
+ * @def SVM_CALC_DESFASE_TICKS
+ * @brief Atraso del cálculo respecto del update del timer de switching [ticks] (sin @ref SVM_SALIDA_GPIO_DMA).
+ * @details TIM2 es esclavo en modo reset del TRGO del timer de switching: cada update lo pone en 0 y su CCR1 interrumpe
+ *          este tiempo después, siempre en la misma fase de la portadora. Basta con que sea posterior al valle: la
+ *          interrupción de switching tiene más prioridad y consume la muestra antes de que el cálculo la reponga.
+ */
+#define SVM_CALC_DESFASE_TICKS          5
+
+/**
+ * @def SVM_TIM1_COMPLEMENTARIAS
+ * @brief 1 para habilitar las salidas complementarias CH1N..CH3N de TIM1 (solo @ref SVM_SALIDA_TIM1).
+ * @details Con remapeo parcial quedan en PA7, PB0 y PB1. PB0 es también @ref GPIO_LED_STATE, que deja de verse.
+ *          Poner en 0 si los drivers generan la rama inferior a partir de IN (como los de la placa actual).
+ */
+#ifndef SVM_TIM1_COMPLEMENTARIAS
+#define SVM_TIM1_COMPLEMENTARIAS        1
+#endif
+
+/**
+ * @def SVM_TIM1_TIEMPO_MUERTO
+ * @brief Campo DTG del BDTR de TIM1 (solo @ref SVM_SALIDA_TIM1). Con tDTS = 1/72 MHz, 72 ≈ 1 µs.
+ */
+#define SVM_TIM1_TIEMPO_MUERTO          72
+
+/**
+ * @def SVM_MUESTREO_DOBLE
+ * @brief 1 para muestrear la referencia en el valle y en el pico de la portadora (PWM asimétrico).
+ * @details Cada mitad del período (subida y bajada) lleva su propia muestra calculada con medio avance de fase, lo que
+ *          duplica la frecuencia de actualización de la modulación sin subir la de switching: menos distorsión con
+ *          frecuencias de salida altas y pocos períodos de portadora por ciclo. El productor calcula dos muestras por
+ *          período. Con @ref SVM_SALIDA_GPIO_ISR el pico se atiende con CCR3 de TIM3 (@ref SWITCH_INT_PICO); con
+ *          @ref SVM_SALIDA_TIM1 el update de TIM1 pasa a ser en valle y pico (RCR = 0). No aplica a @ref SVM_SALIDA_GPIO_DMA.
+ */
+#ifndef SVM_MUESTREO_DOBLE
+#define SVM_MUESTREO_DOBLE              0
+#endif
+
+#if SVM_MUESTREO_DOBLE && SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+#error "SVM_MUESTREO_DOBLE no esta soportado con SVM_SALIDA_GPIO_DMA"
+#endif
+
+/**
+ * @def SVM_HIBRIDO_MODO_DISCONTINUO
+ * @brief Modo discontinuo que usa @ref MODO_PWM_HIBRIDO por encima de @ref SVM_HIBRIDO_INDICE_DISCONTINUO.
+ * @details DPWMMIN solo fija piernas en bajo, por lo que los drivers bootstrap (IR2104) siguen recargando. Con drivers
+ *          aislados, DPWM1 fija la fase de mayor tensión alrededor del pico de corriente y ahorra más.
+ */
+#ifndef SVM_HIBRIDO_MODO_DISCONTINUO
+#define SVM_HIBRIDO_MODO_DISCONTINUO    MODO_PWM_DPWMMIN
+#endif
+
+/**
+ * @def SVM_HIBRIDO_INDICE_DISCONTINUO
+ * @brief Índice de modulación a partir del cual @ref MODO_PWM_HIBRIDO pasa al modo discontinuo (70 = 35 Hz en V/f).
+ */
+#define SVM_HIBRIDO_INDICE_DISCONTINUO  70
+
+/**
+ * @def SVM_HIBRIDO_INDICE_CONTINUO
+ * @brief Índice de modulación hasta el cual @ref MODO_PWM_HIBRIDO vuelve a SVPWM. La diferencia con
+ *        @ref SVM_HIBRIDO_INDICE_DISCONTINUO es la histéresis: una rampa lenta o un índice en el límite no alternan.
+ */
+#define SVM_HIBRIDO_INDICE_CONTINUO     60
+
+#if SVM_HIBRIDO_INDICE_CONTINUO >= SVM_HIBRIDO_INDICE_DISCONTINUO
+#error "SVM_HIBRIDO_INDICE_CONTINUO debe ser menor que SVM_HIBRIDO_INDICE_DISCONTINUO"
+#endif
+
+/**
+ * @def SVM_SINCRONO_RELACION_MAXIMA
+ * @brief Relación portadora/fundamental con la que se entra al PWM sincrónico. 0 deshabilita el modo.
+ * @details Con pocas muestras por ciclo, una portadora asincrónica muestrea la referencia en otra fase en cada ciclo y
+ *          la tensión tiene subarmónicas. En sincrónico el período de cada muestra se ajusta para que N muestras sean
+ *          exactamente un ciclo de salida y la secuencia se repite igual en todos los ciclos. Se entra cuando N·f_out
+ *          alcanza la frecuencia de switching (2511 Hz / 36 = 70 Hz) y N baja de a @ref SVM_SINCRONO_RELACION_PASO a
+ *          medida que sube la velocidad (6 a 400 Hz). Con portadora aleatoria activa, el sincrónico tiene prioridad.
+ */
+#ifndef SVM_SINCRONO_RELACION_MAXIMA
+#define SVM_SINCRONO_RELACION_MAXIMA    36
+#endif
+
+/**
+ * @def SVM_SINCRONO_RELACION_MINIMA
+ * @brief Relación portadora/fundamental mínima del PWM sincrónico.
+ */
+#define SVM_SINCRONO_RELACION_MINIMA    6
+
+/**
+ * @def SVM_SINCRONO_RELACION_PASO
+ * @brief Paso entre relaciones del PWM sincrónico.
+ * @details Múltiplo de 3: las tres fases ven la misma secuencia corrida N/3 muestras (120°). Par: la muestra de θ + 180°
+ *          también es un valle y la salida tiene simetría de media onda (sin armónicas pares).
+ */
+#define SVM_SINCRONO_RELACION_PASO      6
+
+/**
+ * @def SVM_SINCRONO_VENTANA_SHIFT
+ * @brief Histéresis del PWM sincrónico como fracción 1/2^n de la frecuencia de switching (4 = 6.25 %).
+ * @details N baja cuando N·f_out pasa la nominal más la ventana y sube cuando N + paso ya no la pasa; el modo
+ *          termina cuando con la relación máxima la portadora cae una ventana por debajo de la nominal.
+ */
+#define SVM_SINCRONO_VENTANA_SHIFT      4
+
+#if SVM_SINCRONO_RELACION_MAXIMA > 0
+#if (SVM_SINCRONO_RELACION_MAXIMA % SVM_SINCRONO_RELACION_PASO) || (SVM_SINCRONO_RELACION_MINIMA % SVM_SINCRONO_RELACION_PASO)
+#error "Las relaciones del PWM sincronico deben ser multiplos de SVM_SINCRONO_RELACION_PASO"
+#endif
+#if SVM_SINCRONO_RELACION_MINIMA > SVM_SINCRONO_RELACION_MAXIMA
+#error "SVM_SINCRONO_RELACION_MINIMA debe ser menor o igual que SVM_SINCRONO_RELACION_MAXIMA"
+#endif
+#endif
+
+/**
+ * @def SVM_TIEMPO_MUERTO_Q8
+ * @brief Tiempo muerto de los drivers en ticks del timer de switching, Q8 (256 = 1 tick = 1/@ref SVM_FREC_TIMER).
+ * @details Con @ref SVM_SALIDA_TIM1 es @ref SVM_TIM1_TIEMPO_MUERTO (mismo reloj); con los drivers IR2104
+ *          de la placa, su tiempo muerto interno de 520 ns. 0 deshabilita la compensación.
+ */
+#ifndef SVM_TIEMPO_MUERTO_Q8
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+#define SVM_TIEMPO_MUERTO_Q8            (SVM_TIM1_TIEMPO_MUERTO * 256)
+#else
+#define SVM_TIEMPO_MUERTO_Q8            9585
+#endif
+#endif
+
+/**
+ * @def SVM_DESFASE_CORRIENTE
+ * @brief Atraso supuesto de la corriente de fase respecto de la tensión de referencia [grados].
+ * @details Sin medición de corriente, el signo de cada corriente para la compensación de tiempo muerto se estima
+ *          con el ángulo de referencia atrasado este valor.
+ */
+#define SVM_DESFASE_CORRIENTE           30
+
+/**
+ * @def SVM_CANTIDAD_PUENTES
+ * @brief Puentes inversores que maneja el gestor (1 o 2), cada uno con su propio contexto.
+ * @details Cada puente tiene timer de switching, puerto y pines propios (@ref SVM_PUENTE1_TIMER,
+ *          @ref SVM_PUENTE1_PUERTO, @ref SVM_PUENTE1_DESPLAZAMIENTO) y el mismo TIM2 produce las muestras de todos.
+ *          El timer del puente 1 arranca medio período corrido respecto de TIM3: sus flancos caen entre los del
+ *          puente 0 y TIM2, que se dispara en valle y pico de TIM3, queda en la misma fase para los dos.
+ *          Las funciones de configuración y marcha actúan sobre el puente elegido con
+ *          @ref GestorSVM_SeleccionarPuente; el gestor de estados y el SPI manejan el puente 0.
+ *          Solo con @ref SVM_SALIDA_GPIO_ISR.
+ */
+#ifndef SVM_CANTIDAD_PUENTES
+#define SVM_CANTIDAD_PUENTES            1
+#endif
+
+#if SVM_CANTIDAD_PUENTES < 1 || SVM_CANTIDAD_PUENTES > 2
+#error "SVM_CANTIDAD_PUENTES debe ser 1 o 2"
+#endif
+#if SVM_CANTIDAD_PUENTES > 1 && SVM_SALIDA != SVM_SALIDA_GPIO_ISR
+#error "Mas de un puente solo esta soportado con SVM_SALIDA_GPIO_ISR"
+#endif
+
+/**
+ * @def SVM_PUENTE0_TIMER
+ * @brief Timer de switching del puente 0: TIM1 con @ref SVM_SALIDA_TIM1, TIM3 en los demás casos. Salidas en GPIOA.
+ */
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+#define SVM_PUENTE0_TIMER               TIM1
+#else
+#define SVM_PUENTE0_TIMER               TIM3
+#endif
+
+#define SVM_PUENTE1_TIMER               TIM4        /// Timer de switching del puente 1 (misma configuración que TIM3).
+#define SVM_PUENTE1_PUERTO              GPIOB       /// Puerto de las salidas IN y SD del puente 1.
+#define SVM_PUENTE1_DESPLAZAMIENTO      2           /// Pines del puente 1 respecto de GPIO_U_IN..GPIO_W_SD: PB3..PB8 (PB2 es LED_ERROR).
+
+/**
+ * @def SVM_USART1_REMAP
+ * @brief 1 si USART1 (debug) usa el remap a PB6/PB7; 0 para PA9/PA10.
+ * @details Con dos puentes PB6/PB7 son V_SD y W_IN del puente 1, así que USART1 vuelve a PA9/PA10, libres con
+ *          @ref SVM_SALIDA_GPIO_ISR.
+ */
+#ifndef SVM_USART1_REMAP
+#if SVM_CANTIDAD_PUENTES > 1
+#define SVM_USART1_REMAP                0
+#else
+#define SVM_USART1_REMAP                1
+#endif
+#endif
+
+/* El puente 1 ocupa PB(1 + desplazamiento)..PB(6 + desplazamiento): no puede pisar otro uso de GPIOB */
+#if SVM_CANTIDAD_PUENTES > 1 && SVM_PUENTE1_DESPLAZAMIENTO < 2
+#error "Los pines del puente 1 pisan los LED de PB0/PB2"
+#endif
+#if SVM_CANTIDAD_PUENTES > 1 && SVM_USART1_REMAP && SVM_PUENTE1_DESPLAZAMIENTO + 1 <= 7 && SVM_PUENTE1_DESPLAZAMIENTO + 6 >= 6
+#error "Los pines del puente 1 pisan PB6/PB7 de USART1 remapeada: usar SVM_USART1_REMAP = 0"
+#endif
+#if SVM_CANTIDAD_PUENTES > 1 && SVM_PUENTE1_DESPLAZAMIENTO + 6 >= 12
+#error "Los pines del puente 1 pisan SPI2 (PB12..PB15)"
+#endif
+
+/**
+ * @def SVM_CORRIENTE_SHUNT
+ * @brief 1 para reconstruir las corrientes de fase con el shunt único del bus de continua (@ref GPIO_SHUNT, ADC1).
+ * @details Durante un vector activo la corriente del bus es la de una fase: con una sola pierna en alto, la saliente
+ *          de esa fase; con dos, la entrante de la tercera. El CC4 de TIM3 dispara una conversión inyectada en el medio
+ *          de V1 y otra en el medio de V2 de la subida, y con las dos se arman las tres corrientes del período
+ *          (@ref GestorSVM_GetCorrientes). Si un vector activo dura menos que @ref SVM_CORRIENTE_VENTANA_MINIMA, la
+ *          subida lo estira hasta la ventana y la bajada descuenta lo mismo en cada pierna, así que la tensión media
+ *          del período no cambia. Por eso requiere la tabla asimétrica de @ref SVM_MUESTREO_DOBLE, con
+ *          @ref SVM_SALIDA_GPIO_ISR y un solo puente.
+ */
+#ifndef SVM_CORRIENTE_SHUNT
+#define SVM_CORRIENTE_SHUNT             0
+#endif
+
+#if SVM_CORRIENTE_SHUNT && (SVM_SALIDA != SVM_SALIDA_GPIO_ISR || !SVM_MUESTREO_DOBLE || SVM_CANTIDAD_PUENTES > 1)
+#error "SVM_CORRIENTE_SHUNT requiere SVM_SALIDA_GPIO_ISR, SVM_MUESTREO_DOBLE y un solo puente"
+#endif
+
+/**
+ * @def SVM_CORRIENTE_VENTANA_MINIMA
+ * @brief Duración mínima de V1 y V2 en la subida con @ref SVM_CORRIENTE_SHUNT [ticks]: 4 µs.
+ * @details La conversión arranca en el medio de la ventana: la primera mitad cubre tiempo muerto, ringing y
+ *          asentamiento del amplificador. Entre las dos conversiones entra una conversión (1.7 µs) más el ISR que
+ *          mueve el CC4, y la ventana es mayor que la latencia del ISR de switching, por lo que la tabla de flancos
+ *          no elimina ningún vector activo.
+ */
+#define SVM_CORRIENTE_VENTANA_MINIMA    ((SVM_FREC_TIMER / 1000000) * 4)
+
+/**
+ * @def SVM_CORRIENTE_MUESTREO_MINIMO
+ * @brief Primer disparo más temprano después del valle [ticks]: 2 µs, para que el RESET llegue a escribir el CC4.
+ */
+#define SVM_CORRIENTE_MUESTREO_MINIMO   ((SVM_FREC_TIMER / 1000000) * 2)
+
+/**
+ * @def SVM_CORRIENTE_CERO_ADC
+ * @brief Lectura del ADC con corriente nula: el amplificador del shunt está polarizado a media escala.
+ */
+#define SVM_CORRIENTE_CERO_ADC          2048
+
+/**
+ * @def SVM_CORRIENTE_MA_POR_CUENTA_Q8
+ * @brief Ganancia de la medición [mA por cuenta del ADC], Q8. Shunt de 10 mΩ, amplificador ×20 y 3.3 V / 4096:
+ *        4.03 mA por cuenta.
+ */
+#define SVM_CORRIENTE_MA_POR_CUENTA_Q8  1031
+
+/** @name Fuentes de la tensión del bus
+ *  @brief Valores posibles de @ref SVM_VBUS_FUENTE.
+ *  @{
+ */
+#define SVM_VBUS_NINGUNA                0           /// Sin compensación: el índice de modulación sale solo de la frecuencia.
+#define SVM_VBUS_SPI                    1           /// Tensión medida por el ESP32 y recibida por SPI (@ref GestorSVM_SetTensionBus).
+#define SVM_VBUS_ADC                    2           /// Tensión medida por el ADC2 en @ref GPIO_VBUS, en conversión continua.
+/** @} */
+
+/**
+ * @def SVM_VBUS_FUENTE
+ * @brief Fuente de la tensión del bus con la que se compensa el índice de modulación. Se puede definir desde las
+ *        opciones del compilador.
+ * @details La fundamental de salida es proporcional al índice y a la tensión del bus: con el bus caído, el índice de la
+ *          rampa da menos tensión y el motor pierde flujo y par. Con una fuente elegida, el índice V/f (pensado para
+ *          @ref SVM_VBUS_NOMINAL) se multiplica por @ref SVM_VBUS_NOMINAL / Vbus filtrada, con la escala limitada a
+ *          @ref SVM_VBUS_ESCALA_MINIMA_Q16..@ref SVM_VBUS_ESCALA_MAXIMA_Q16 y el índice a @ref INDICE_MODULACION_MAXIMO.
+ *          El productor filtra la medición una vez por interrupción y cada puente recalcula su modulación en la
+ *          muestra siguiente, también a velocidad constante.
+ *          Con @ref SVM_VBUS_SPI la medición es el promedio de 2 s del ESP32: compensa la caída lenta de una red débil,
+ *          no el rizado. Con @ref SVM_VBUS_ADC el filtro recibe una conversión por interrupción del productor y
+ *          compensa también el rizado del rectificador.
+ */
+#ifndef SVM_VBUS_FUENTE
+#define SVM_VBUS_FUENTE                 SVM_VBUS_NINGUNA
+#endif
+
+#if SVM_VBUS_FUENTE == SVM_VBUS_ADC && SVM_SALIDA == SVM_SALIDA_TIM1 && SVM_TIM1_COMPLEMENTARIAS
+#error "SVM_VBUS_ADC usa PA7, que es TIM1_CH1N con SVM_TIM1_COMPLEMENTARIAS: usar SVM_VBUS_SPI o SVM_TIM1_COMPLEMENTARIAS = 0"
+#endif
+
+#define SVM_VBUS_NOMINAL                311         /// Tensión del bus para la que está pensada la relación V/f [V]: 220 Vca rectificada.
+#define SVM_VBUS_ESCALA_MINIMA_Q16      52429       /// Escala mínima del índice, Q16 (0.8): acota la corrección con el bus alto (frenado).
+#define SVM_VBUS_ESCALA_MAXIMA_Q16      98304       /// Escala máxima del índice, Q16 (1.5): por debajo de 2/3 del nominal ya no se compensa.
+
+/**
+ * @def SVM_VBUS_FILTRO_SHIFT
+ * @brief Filtro de primer orden de la tensión del bus: en cada interrupción del productor la tensión filtrada se acerca
+ *        1/2^n a la medición (0 = sin filtro).
+ * @details La constante de tiempo es de 2^n interrupciones del productor. Con 3 y la frecuencia de switching por
+ *          defecto es de 1.6 ms con TIM3, donde TIM2 interrumpe en el valle y en el pico; de 3.2 ms con
+ *          @ref SVM_SALIDA_TIM1, donde TIM2 interrumpe solo en el valle (RCR = 1; 1.6 ms con @ref SVM_MUESTREO_DOBLE,
+ *          que usa RCR = 0); y de 6.4 ms con
+ *          @ref SVM_SALIDA_GPIO_DMA, una interrupción cada @ref SVM_DMA_PERIODOS_POR_MITAD períodos. Deja pasar el
+ *          rizado de 100 Hz, que es lo que se quiere compensar con @ref SVM_VBUS_ADC, y saca el ruido de la conversión.
+ */
+#ifndef SVM_VBUS_FILTRO_SHIFT
+#define SVM_VBUS_FILTRO_SHIFT           3
+#endif
+
+/**
+ * @def SVM_VBUS_VOLTIOS_POR_CUENTA_Q16
+ * @brief Ganancia de la medición del bus con @ref SVM_VBUS_ADC [V por cuenta del ADC], Q16. Divisor de 450 V a
+ *        3.3 V: 0.11 V por cuenta.
+ */
+#define SVM_VBUS_VOLTIOS_POR_CUENTA_Q16 7200
+
+/**
+ * @def SVM_PERFIL
+ * @brief 1 para medir con el contador de ciclos del DWT la duración de cada camino de interrupción del SVM
+ *        (@ref CaminoPerfilSVM). Se puede definir desde las opciones del compilador.
+ * @details Cada medición agrega dos lecturas de CYCCNT y unos 40 ciclos de acumulación al camino medido. Con 0 las
+ *          macros de medición quedan vacías y no hay costo. Sirve para dimensionar la frecuencia de switching: el
+ *          máximo del RESET y del FLANCO contra @ref MIN_TICKS_DIF, y el del cálculo contra el período.
+ */
+#ifndef SVM_PERFIL
+#define SVM_PERFIL                      0
+#endif
 
 /**
  * @fn void GestorSVM_Init(void)
@@ -141,7 +561,7 @@ int GestorSVM_Estop();
 /**
  * @fn int GestorSVM_SetFrec(int frec)
  * @brief Solicita una nueva frecuencia objetivo.
- * @param frec Frecuencia objetivo [Hz].
+ * @param frec Frecuencia objetivo [1/@ref FREC_RESOLUCION Hz], p.ej. 5012 = 50.12 Hz.
  * @return
  *   -  0: Aceptada con motor detenido (queda como referencia).
  *   -  1: Aceptada con motor en marcha (inicia rampa).
@@ -149,7 +569,8 @@ int GestorSVM_Estop();
  *   - -2: Igual a la frecuencia actual (sin cambios).
  * @details
  *   Calcula delta por ciclo a partir de @ref acel/@ref desacel y @ref frec_switch,
- *   y actualiza parámetros sombra para el lazo de cálculo.
+ *   y actualiza parámetros sombra para el lazo de cálculo. Un ajuste de centésimas con el motor en marcha
+ *   se alcanza en pocos períodos de la rampa, sin pasar por el arranque.
  */
 int GestorSVM_SetFrec(int frec);
 
@@ -162,7 +583,8 @@ int GestorSVM_SetFrec(int frec);
  *   - -1: Fuera de rango.
  *   - -2: Rechazado (motor en marcha o cambio en curso).
  * @details
- *   Recalcula la tabla BSRR por cuadrante para invertir U/V.
+ *   Las tablas BSRR de ambos sentidos (U/V invertidas) se generan en compilación; el cambio es un puntero que el
+ *   productor toma entre dos muestras.
  */
 int GestorSVM_SetDir(int dir);
 
@@ -182,10 +604,116 @@ int GestorSVM_SetAcel(int acel);
  */
 int GestorSVM_SetDecel(int decel);
 
+/**
+ * @fn int GestorSVM_SetFrecuenciaSwitching(int frec)
+ * @brief Cambia la frecuencia de switching (solo con motor detenido).
+ * @param frec Frecuencia de switching [Hz], @ref FREC_SWITCH_MINIMA..@ref FREC_SWITCH_MAXIMA.
+ * @return
+ *   -  0: Modificada.
+ *   - -1: Fuera de rango.
+ *   - -2: Rechazado (motor en marcha o cambio en curso).
+ * @details
+ *   El timer de switching cuenta sin prescaler: ARR = @ref SVM_FREC_TIMER / (2·frec) en center-aligned. El timer de
+ *   cálculo no se toca: es esclavo del TRGO del de switching, así que interrumpe en valle y pico con TIM3 y solo en el
+ *   valle con TIM1 (RCR = 1). La frecuencia efectiva es la que resulta del ARR entero
+ *   (@ref GestorSVM_GetFrecuenciaSwitching). El incremento de fase y las rampas se recalculan con ella.
+ * @note Con @ref SVM_SALIDA_GPIO_ISR son siete interrupciones por período: por encima de unos 10 kHz conviene
+ *       @ref SVM_SALIDA_GPIO_DMA o @ref SVM_SALIDA_TIM1.
+ */
+int GestorSVM_SetFrecuenciaSwitching(int frec);
+
+/**
+ * @fn int GestorSVM_GetFrecuenciaSwitching(void)
+ * @brief Obtiene la frecuencia de switching efectiva [Hz].
+ */
+int GestorSVM_GetFrecuenciaSwitching();
+
+/**
+ * @fn int GestorSVM_SetModoPWM(int modo)
+ * @brief Selecciona el reparto del tiempo nulo (@ref ModoPWM).
+ * @param modo Valor de @ref ModoPWM.
+ * @return 0 OK; -1 fuera de rango.
+ * @details Se puede cambiar en marcha. El productor lo aplica al entrar en el sector siguiente, donde la secuencia de
+ *          conmutación cambia de todos modos: no queda un período con una secuencia a medias.
+ */
+int GestorSVM_SetModoPWM(int modo);
+
+/**
+ * @fn int GestorSVM_GetModoPWM(void)
+ * @brief Obtiene el modo de PWM actual (@ref ModoPWM).
+ */
+int GestorSVM_GetModoPWM();
+
+/**
+ * @fn int GestorSVM_SetModulador(int tipo)
+ * @brief Selecciona el modulador (@ref TipoModulador): SVPWM, SPWM o THIPWM.
+ * @param tipo Valor de @ref TipoModulador.
+ * @return 0 OK; -1 fuera de rango.
+ * @details Se puede cambiar en marcha: se aplica desde la próxima muestra calculada. Los tres usan la misma ganancia,
+ *          así que la fundamental no salta mientras no se supere la región lineal del elegido (SPWM: índice 90).
+ *          @ref ModoPWM se aplica igual sobre cualquiera de ellos.
+ */
+int GestorSVM_SetModulador(int tipo);
+
+/**
+ * @fn int GestorSVM_GetModulador(void)
+ * @brief Obtiene el modulador actual (@ref TipoModulador).
+ */
+int GestorSVM_GetModulador();
+
+/**
+ * @fn int GestorSVM_SetTiempoMuerto(int nuevoTiempoMuerto, int nuevoDesfase)
+ * @brief Configura la compensación de tiempo muerto.
+ * @param nuevoTiempoMuerto Tiempo muerto en ticks del timer de switching, Q8 (0 = sin compensación).
+ * @param nuevoDesfase Atraso de la corriente respecto de la tensión [grados], 0..90.
+ * @return 0 OK; -1 fuera de rango.
+ * @details
+ *   En cada flanco la pierna queda con el diodo que corresponde al signo de su corriente: con corriente saliente
+ *   pierde el tiempo muerto de alto por período, con corriente entrante lo gana. Se corrige cada CCR en ±Td/2.
+ *   Se puede cambiar en marcha.
+ */
+int GestorSVM_SetTiempoMuerto(int nuevoTiempoMuerto, int nuevoDesfase);
+
+/**
+ * @fn int GestorSVM_SetDispersionPortadora(int porcentaje)
+ * @brief Configura la portadora aleatoria (spread spectrum).
+ * @param porcentaje Dispersión del período de switching [%], 0..@ref DISPERSION_PORTADORA_MAXIMA (0 = portadora fija).
+ * @return 0 OK; -1 fuera de rango.
+ * @details
+ *   Cada período toma un ARR al azar, uniforme en ±porcentaje alrededor del nominal: la energía del tono de la
+ *   portadora y sus bandas laterales se reparte en una banda continua. La distribución es simétrica, por lo que
+ *   el período medio (y la cantidad de conmutaciones por segundo) no cambia. Los tiempos y el avance de fase de
+ *   cada muestra se calculan con su propio período. Se puede cambiar en marcha.
+ */
+int GestorSVM_SetDispersionPortadora(int porcentaje);
+
+/**
+ * @fn int GestorSVM_GetDispersionPortadora(void)
+ * @brief Obtiene la dispersión de la portadora [%].
+ */
+int GestorSVM_GetDispersionPortadora();
+
+/**
+ * @fn int GestorSVM_SetTensionBus(int tension)
+ * @brief Carga la tensión del bus medida por el ESP32 (@ref SVM_VBUS_SPI).
+ * @param tension Tensión del bus [V], 1..2·@ref SVM_VBUS_NOMINAL.
+ * @return 0 OK; -1 fuera de rango; -2 la fuente de la tensión del bus no es @ref SVM_VBUS_SPI.
+ * @details Se puede llamar en cualquier estado. El productor la filtra y corrige el índice de modulación desde la
+ *          muestra siguiente.
+ */
+int GestorSVM_SetTensionBus(int tension);
+
+/**
+ * @fn int GestorSVM_GetTensionBus(void)
+ * @brief Obtiene la tensión del bus filtrada con la que se compensa el índice [V].
+ * @return Tensión filtrada; 0 sin medición todavía o sin @ref SVM_VBUS_FUENTE.
+ */
+int GestorSVM_GetTensionBus();
+
 /**
  * @fn int GestorSVM_GetFrec(void)
- * @brief Lee la frecuencia objetivo de referencia (no escalada).
- * @return Frecuencia de referencia [Hz].
+ * @brief Lee la frecuencia objetivo de referencia.
+ * @return Frecuencia de referencia [1/@ref FREC_RESOLUCION Hz].
  * @note Si querés la frecuencia *instantánea* en rampa, podrías exponer otra API.
  */
 int GestorSVM_GetFrec();
@@ -210,16 +738,97 @@ int GestorSVM_GetDesacel();
  */
 int GestorSVM_GetDir();
 
+/**
+ * @fn int GestorSVM_SeleccionarPuente(int puente)
+ * @brief Elige el puente (0..@ref SVM_CANTIDAD_PUENTES - 1) sobre el que actúan las demás funciones de la API.
+ * @param puente Índice del puente.
+ * @return 0 OK; -1 fuera de rango.
+ * @details @ref GestorSVM_Estop detiene todos los puentes, sin importar cuál esté elegido.
+ */
+int GestorSVM_SeleccionarPuente(int puente);
+
+/**
+ * @fn int GestorSVM_GetPuente(void)
+ * @brief Devuelve el puente elegido con @ref GestorSVM_SeleccionarPuente.
+ */
+int GestorSVM_GetPuente();
+
 /**
  * @fn void GestorSVM_CalcInterrupt(void)
  * @brief ISR (o handler llamado por ISR) del timer de cálculo.
  * @details
- *   Corre a 2× @ref FREC_SWITCH (según tu diseño) para anticipar cómputos:
- *   si el buffer circular tiene espacio, calcula t1/t2/t3, cuadrante y
- *   posibles interferencias, y los encola para que el timer de switching
- *   (TIM3) los consuma. No bloquea si el buffer está lleno.
- * @note Tamaño de buffer: 3 entradas (pipeline productor/consumidor).
+ *   TIM2 es esclavo del timer de switching (TRGO del update → ITR) y esta
+ *   interrupción llega @ref SVM_CALC_DESFASE_TICKS después de cada update: en
+ *   el valle y en el pico con TIM3, solo en el valle con TIM1. Si el buffer
+ *   circular tiene espacio, calcula t1/t2/t3 y cuadrante, arma la muestra del
+ *   período y la encola para que el timer de switching la consuma. No
+ *   bloquea si el buffer está lleno.
+ * @note Buffer de 2^BUFFER_CALCULO_BITS entradas, hasta BUFFER_CALCULO_LOTE muestras por interrupción.
  */
 void GestorSVM_CalcInterrupt();
 
+/**
+ * @fn void GestorSVM_SwitchTimerInterrupt(int puente)
+ * @brief Handler de la IRQ del timer de switching: TIM3 (TIM4 del puente 1) con @ref SVM_SALIDA_GPIO_ISR, TIM1_UP con
+ *        @ref SVM_SALIDA_TIM1.
+ * @param puente Puente dueño del timer que interrumpió.
+ * @details Se llama directo desde la IRQ, en lugar de HAL_TIM_IRQHandler: lee SR una vez, limpia los flags atendidos y
+ *          despacha al código de switching.
+ */
+void GestorSVM_SwitchTimerInterrupt(int puente);
+
+/**
+ * @fn void GestorSVM_GetEstadisticasBuffer(EstadisticasBufferSVM* estadisticas)
+ * @brief Copia las estadísticas de ocupación y faltantes del buffer de cálculo.
+ * @param estadisticas Destino de la copia.
+ * @note Se puede llamar con el motor en marcha: cada campo lo escribe un solo lado del buffer.
+ */
+void GestorSVM_GetEstadisticasBuffer(EstadisticasBufferSVM* estadisticas);
+
+/**
+ * @fn int GestorSVM_GetCorrientes(CorrientesSVM* corrientes)
+ * @brief Copia las últimas corrientes de fase reconstruidas del puente 0 (@ref SVM_CORRIENTE_SHUNT).
+ * @param corrientes Destino de la copia.
+ * @return 0 OK; -1 sin períodos reconstruidos desde el arranque o sin @ref SVM_CORRIENTE_SHUNT.
+ * @note Se puede llamar con el motor en marcha: la copia se repite si el productor actualizó las corrientes en el medio.
+ */
+int GestorSVM_GetCorrientes(CorrientesSVM* corrientes);
+
+/**
+ * @fn int GestorSVM_GetPerfil(int camino, PerfilSVM* perfil)
+ * @brief Copia la medición de un camino de interrupción (@ref SVM_PERFIL).
+ * @param camino Valor de @ref CaminoPerfilSVM.
+ * @param perfil Destino de la copia.
+ * @return 0 OK; -1 camino fuera de rango; -2 sin @ref SVM_PERFIL.
+ * @note Se puede llamar con el motor en marcha: la copia se repite si el camino registró otra ejecución en el medio.
+ */
+int GestorSVM_GetPerfil(int camino, PerfilSVM* perfil);
+
+/**
+ * @fn int GestorSVM_ResetPerfil(void)
+ * @brief Reinicia las mediciones de todos los caminos (@ref SVM_PERFIL).
+ * @return 0 OK; -2 sin @ref SVM_PERFIL.
+ * @details No deshabilita interrupciones: cada camino descarta lo acumulado en su próxima ejecución.
+ */
+int GestorSVM_ResetPerfil();
+
+/**
+ * @fn void GestorSVM_CorrienteInterrupt(void)
+ * @brief Fin de una conversión inyectada del shunt (IRQ del ADC1, @ref SVM_CORRIENTE_SHUNT).
+ * @details Guarda la lectura del vector activo en curso y lleva el CC4 de TIM3 al medio del vector siguiente, o lo
+ *          deshabilita después del segundo para que la bajada no dispare otra conversión.
+ */
+void GestorSVM_CorrienteInterrupt();
+
+/**
+ * @fn void GestorSVM_DMAInterrupt(int mitad)
+ * @brief Handler de media transferencia / transferencia completa del DMA de BSRR (@ref SVM_SALIDA_GPIO_DMA).
+ * @param mitad Mitad del buffer que el DMA terminó de leer y se debe recalcular (0 o 1).
+ * @details
+ *   Calcula @ref SVM_DMA_PERIODOS_POR_MITAD períodos y escribe, por cada uno, las seis
+ *   palabras BSRR y la duración de cada intervalo. Reemplaza a TIM2 y al buffer de
+ *   cálculo: la CPU solo interviene una vez por mitad de buffer.
+ */
+void GestorSVM_DMAInterrupt(int mitad);
+
 #endif /* GESTOR_SVM_GESTORSVM_H_ */
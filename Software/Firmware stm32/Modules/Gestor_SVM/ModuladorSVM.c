@@ -0,0 +1,126 @@
+/**
+ * @file ModuladorSVM.c
+ * @brief Implementación de los moduladores SVPWM, SPWM y THIPWM sobre el núcleo de @ref CalculoSVM.h.
+ * @details
+ *   SPWM y THIPWM calculan la posición de cada fase en Q31 de tick (T/2 − A·v, A en Q16 y v en Q15), las ordenan y
+ *   cuantizan las diferencias con el mismo sigma-delta que t1/t2 de SVPWM: el tiempo de los vectores activos conserva
+ *   la resolución del cálculo y el primer flanco se redondea (solo mueve la tensión de modo común).
+ *   Se ejecutan desde SRAM (@ref RAM_FUNC), igual que el productor que las llama.
+ */
+
+#include <stddef.h>
+#include "ModuladorSVM.h"
+#include "../Inc/main.h"
+
+/** @brief 120° en unidades de fase (2^32 / 3). */
+#define FASE_120_GRADOS     1431655765UL
+/** @brief 1/√3 en Q16: amplitud de fase por unidad de ganancia de t1/t2. */
+#define INV_RAIZ3_Q16       37837
+/** @brief 1/6 en Q15: tercera armónica de THIPWM. */
+#define UN_SEXTO_Q15        5461
+
+/**
+ * @brief Ordena las posiciones de fase y las lleva a los tres flancos de la salida.
+ * @param posicion Posición de cada fase {U, V, W} en ticks Q31, ya recortada a 0..ticksPeriodo.
+ * @param ticksPeriodo Ticks de medio período.
+ * @param resto Estado del sigma-delta de las dos diferencias, o NULL para redondear.
+ * @param salida Destino de ticksC1/C2/C3 (el sector lo completa quien llama).
+ */
+static RAM_FUNC void ModuladorSVM_Ordenar(int64_t* posicion, int ticksPeriodo, RestoTiemposSVM* resto, SalidaModulador* salida) {
+    int64_t p0 = posicion[0], p1 = posicion[1], p2 = posicion[2], aux;
+    int c0, t1, t2;
+
+    /* Tres comparaciones: la fase de mayor tensión (menor CCR) enciende primero */
+    if (p0 > p1) {
+        aux = p0;
+        p0 = p1;
+        p1 = aux;
+    }
+    if (p1 > p2) {
+        aux = p1;
+        p1 = p2;
+        p2 = aux;
+    }
+    if (p0 > p1) {
+        aux = p0;
+        p0 = p1;
+        p1 = aux;
+    }
+
+    /* t1/t2 con el sigma-delta; el primer flanco redondeado */
+    t1 = CalculoSVM_Cuantizar((uint64_t)(p1 - p0), resto ? resto->error[0] : NULL);
+    t2 = CalculoSVM_Cuantizar((uint64_t)(p2 - p1), resto ? resto->error[1] : NULL);
+    c0 = (int)((p0 + (1LL << 30)) >> 31);
+
+    salida->ticks[0] = c0;
+    salida->ticks[1] = c0 + t1;
+    salida->ticks[2] = c0 + t1 + t2;
+
+    /* El redondeo puede pasar el pico en un tick; saturar mantiene el orden */
+    if (salida->ticks[2] > ticksPeriodo) {
+        salida->ticks[2] = ticksPeriodo;
+        if (salida->ticks[1] > ticksPeriodo) {
+            salida->ticks[1] = ticksPeriodo;
+            if (salida->ticks[0] > ticksPeriodo) {
+                salida->ticks[0] = ticksPeriodo;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Posición Q31 de una fase de tensión v (Q15) con amplitud A (Q16), recortada a 0..ticksPeriodo.
+ */
+static RAM_FUNC int64_t ModuladorSVM_Posicion(uint32_t amplitud, int32_t v, int ticksPeriodo) {
+    int64_t posicion = ((int64_t)ticksPeriodo << 30) - (int64_t)amplitud * v;
+
+    if (posicion < 0) {
+        return 0;
+    }
+    if (posicion > ((int64_t)ticksPeriodo << 31)) {
+        return (int64_t)ticksPeriodo << 31;
+    }
+    return posicion;
+}
+
+RAM_FUNC void ModuladorSVM_SVPWM(uint32_t fase, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, SalidaModulador* salida) {
+    TiemposSVM tiempos;
+    uint32_t anguloSector;
+
+    anguloSector = CalculoSVM_AnguloSector(fase, &salida->sector);
+    CalculoSVM_Tiempos(anguloSector, modulacion, ticksPeriodo, resto, &tiempos);
+
+    salida->ticks[0] = tiempos.t0;
+    salida->ticks[1] = tiempos.t0 + tiempos.t1;
+    salida->ticks[2] = tiempos.t0 + tiempos.t1 + tiempos.t2;
+}
+
+RAM_FUNC void ModuladorSVM_SPWM(uint32_t fase, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, SalidaModulador* salida) {
+    uint32_t amplitud = (uint32_t)(((uint64_t)modulacion->ganancia * INV_RAIZ3_Q16) >> 16);
+    int64_t posicion[3];
+
+    salida->sector = (int)(((uint64_t)fase * 6) >> 32);
+
+    posicion[0] = ModuladorSVM_Posicion(amplitud, CalculoSVM_Coseno(fase), ticksPeriodo);
+    posicion[1] = ModuladorSVM_Posicion(amplitud, CalculoSVM_Coseno(fase - FASE_120_GRADOS), ticksPeriodo);
+    posicion[2] = ModuladorSVM_Posicion(amplitud, CalculoSVM_Coseno(fase + FASE_120_GRADOS), ticksPeriodo);
+
+    ModuladorSVM_Ordenar(posicion, ticksPeriodo, resto, salida);
+}
+
+RAM_FUNC void ModuladorSVM_THIPWM(uint32_t fase, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, SalidaModulador* salida) {
+    uint32_t amplitud = (uint32_t)(((uint64_t)modulacion->ganancia * INV_RAIZ3_Q16) >> 16);
+    int32_t tercera;
+    int64_t posicion[3];
+
+    salida->sector = (int)(((uint64_t)fase * 6) >> 32);
+
+    /* cos(3θ) es el mismo para las tres fases (3·120° = 360°). Se resta: en θ = 0 la fase U está en su pico */
+    tercera = -((CalculoSVM_Coseno(fase * 3) * UN_SEXTO_Q15) >> 15);
+
+    posicion[0] = ModuladorSVM_Posicion(amplitud, CalculoSVM_Coseno(fase) + tercera, ticksPeriodo);
+    posicion[1] = ModuladorSVM_Posicion(amplitud, CalculoSVM_Coseno(fase - FASE_120_GRADOS) + tercera, ticksPeriodo);
+    posicion[2] = ModuladorSVM_Posicion(amplitud, CalculoSVM_Coseno(fase + FASE_120_GRADOS) + tercera, ticksPeriodo);
+
+    ModuladorSVM_Ordenar(posicion, ticksPeriodo, resto, salida);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file ModuladorSVM.h
+ * @brief Interfaz común de los moduladores del gestor SVM: SVPWM, SPWM seno-triángulo y THIPWM.
+ * @details
+ *   Todos los moduladores reciben la fase de la referencia, la modulación (@ref ModulacionSVM, del índice de
+ *   modulación) y los ticks del medio período, y entregan el sector y los tres flancos ordenados
+ *   (@ref SalidaModulador). Lo que sigue (reparto del tiempo nulo, tiempo muerto, tabla de flancos o CCR) no
+ *   depende del modulador.
+ *
+ *   Con una portadora triangular, comparar tres referencias de fase equivale a una secuencia de sector: la fase de
+ *   mayor tensión enciende primero y la de menor, última. Por eso SPWM y THIPWM ordenan los tres CCR de fase y
+ *   reutilizan todo el camino de SVPWM. Las tres referencias solo difieren en la secuencia cero (el reparto de t0):
+ *   - SVPWM: t0 centrado, lineal hasta @ref CALCULO_SVM_INDICE_LINEAL (tensión de fase Vdc/√3).
+ *   - SPWM: sin secuencia cero, lineal hasta el índice 90 (Vdc/2). Por encima, las fases se recortan en los rieles.
+ *   - THIPWM: tercera armónica de 1/6 de la fundamental, lineal hasta @ref CALCULO_SVM_INDICE_LINEAL.
+ *
+ *   La comparación de fundamental, THD y costo por muestra está en
+ *   "SVM Space Vector Modulation/SVM_Moduladores.py".
+ */
+
+#ifndef GESTOR_SVM_MODULADORSVM_H_
+#define GESTOR_SVM_MODULADORSVM_H_
+
+#include <stdint.h>
+#include "CalculoSVM.h"
+
+/**
+ * @enum TipoModulador
+ * @brief Moduladores disponibles (ver @ref GestorSVM_SetModulador).
+ */
+typedef enum {
+    MODULADOR_SVPWM = 0,    /// Vectores espaciales: t1/t2 exactos del sector y t0 repartido (@ref CalculoSVM_Tiempos).
+    MODULADOR_SPWM,         /// Seno-triángulo: una senoidal por fase, sin secuencia cero.
+    MODULADOR_THIPWM,       /// Seno-triángulo con inyección de tercera armónica (1/6).
+    MODULADOR_CANTIDAD      /// Cantidad de moduladores (no es un modulador).
+} TipoModulador;
+
+/**
+ * @struct SalidaModulador
+ * @brief Resultado de un modulador para una muestra.
+ * @details ticks[k] es el flanco de la k-ésima fase que enciende en la secuencia del sector (la de mayor tensión
+ *          primero), contado desde el valle: ticksC1 <= ticksC2 <= ticksC3, todos en 0..ticksPeriodo.
+ */
+typedef struct SalidaModulador {
+    int sector;     /// Sector de la referencia (0..5).
+    int ticks[3];   /// ticksC1/C2/C3 del medio período.
+} SalidaModulador;
+
+/**
+ * @brief Firma común de los moduladores.
+ * @param fase Fase de la referencia (2^32 = 360°); la fase U es cos(fase).
+ * @param modulacion Parámetros del índice de modulación (@ref CalculoSVM_Modulacion).
+ * @param ticksPeriodo Ticks de medio período del timer de switching.
+ * @param resto Estado del sigma-delta de t1/t2, o NULL para redondear.
+ * @param salida Resultado.
+ */
+typedef void (*FuncionModulador)(uint32_t fase, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, SalidaModulador* salida);
+
+/**
+ * @fn void ModuladorSVM_SVPWM(uint32_t fase, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, SalidaModulador* salida)
+ * @brief Modulación por vectores espaciales: @ref CalculoSVM_Tiempos con t0 centrado (incluye sobremodulación).
+ */
+void ModuladorSVM_SVPWM(uint32_t fase, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, SalidaModulador* salida);
+
+/**
+ * @fn void ModuladorSVM_SPWM(uint32_t fase, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, SalidaModulador* salida)
+ * @brief Seno-triángulo: CCR de cada fase = T/2 − A·cos(θ − k·120°), con A = ganancia/√3.
+ * @details Con la misma ganancia que SVPWM da la misma fundamental mientras no recorta. La retención de
+ *          sobremodulación modo II no aplica: por encima de la región lineal las fases se recortan en 0 y T.
+ */
+void ModuladorSVM_SPWM(uint32_t fase, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, SalidaModulador* salida);
+
+/**
+ * @fn void ModuladorSVM_THIPWM(uint32_t fase, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, SalidaModulador* salida)
+ * @brief Seno-triángulo con tercera armónica: cos(θ − k·120°) − cos(3θ)/6 en cada fase.
+ * @details cos(3θ) es igual en las tres fases y se calcula una vez por muestra. El pico de la suma es √3/2 del de la
+ *          fundamental, lo que extiende la región lineal hasta la de SVPWM.
+ */
+void ModuladorSVM_THIPWM(uint32_t fase, const ModulacionSVM* modulacion, int ticksPeriodo, RestoTiemposSVM* resto, SalidaModulador* salida);
+
+#endif /* GESTOR_SVM_MODULADORSVM_H_ */
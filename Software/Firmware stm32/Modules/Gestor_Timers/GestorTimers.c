@@ -1,55 +1,225 @@
 #include "../Gestor_Timers/GestorTimers.h"
 
 #include "../Inc/main.h"
+#include "../Gestor_SVM/GestorSVM.h"
 
 // Este gestor va a mantener los timers. A este le vamos a pedir que nos inicie
 // y detenga los timers.
 // Los posibles timers ya estan establecidos
 
 
-// Dos punteros a las variables de timer
-TIM_HandleTypeDef* hTimerSwitch;
+// Punteros a las variables de timer: uno de switching por puente y el de calculo, comun a todos
+TIM_HandleTypeDef* hTimerSwitch[SVM_CANTIDAD_PUENTES];
 TIM_HandleTypeDef* hTimerCalc;
 
+// Puentes con el timer de switching en marcha, un bit por puente
+static uint32_t puentesActivos;
+
 void GestorTimers_Init(TIM_HandleTypeDef* _hTimerSwitch, TIM_HandleTypeDef* _hTimerCalc) {
-    hTimerSwitch = _hTimerSwitch;
+    hTimerSwitch[0] = _hTimerSwitch;
     hTimerCalc = _hTimerCalc;
 }
 
+void GestorTimers_InitPuente(int puente, TIM_HandleTypeDef* _hTimerSwitch) {
+    if (puente > 0 && puente < SVM_CANTIDAD_PUENTES) {
+        hTimerSwitch[puente] = _hTimerSwitch;
+    }
+}
+
+
+void GestorTimers_ConfigurarPeriodo(int puente, int ticksPeriodo) {
+    TIM_HandleTypeDef* hTimer = hTimerSwitch[puente];
+
+    // Antes de GestorTimers_Init el periodo lo toman los MX_TIMx_Init
+    if (hTimer == NULL || hTimerCalc == NULL) {
+        return;
+    }
+
+#if SVM_SALIDA != SVM_SALIDA_GPIO_DMA
+    // Contador en marcha por otro puente: el UG lo reiniciaria (y con TIM3 tambien a TIM2). El ARR lo carga el ISR
+    // en cada valle con el periodo de la muestra
+    if (hTimer->Instance->CR1 & TIM_CR1_CEN) {
+        return;
+    }
+
+    // En center-aligned el ARR es medio periodo. Con DMA el ARR lo escribe el DMA intervalo a intervalo
+    __HAL_TIM_SET_AUTORELOAD(hTimer, ticksPeriodo);
+    hTimer->Instance->EGR = TIM_EGR_UG;
+    __HAL_TIM_CLEAR_FLAG(hTimer, TIM_FLAG_UPDATE);
+#endif
 
-void GestorTimers_IniciarTimerSVM() {
+    // El timer de calculo no depende del periodo: lo reinicia cada update del timer de switching
+}
+
+
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+// Callbacks del DMA de BSRR: la mitad ya consumida se recalcula
+static void GestorTimers_DMAMitadCallback(DMA_HandleTypeDef* hdma) {
+    GestorSVM_DMAInterrupt(0);
+}
+
+static void GestorTimers_DMACompletoCallback(DMA_HandleTypeDef* hdma) {
+    GestorSVM_DMAInterrupt(1);
+}
 
-    // Seteo de la prioridad del timer 2 a la segunda mas alta (1)
-    HAL_NVIC_SetPriority(TIM2_IRQn, 1, 0);
-    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+void GestorTimers_IniciarTimerSVMDMA(uint32_t* palabrasBSRR, uint16_t* duracionesARR, int largo) {
+    DMA_HandleTypeDef* hdmaBSRR = hTimerSwitch[0]->hdma[TIM_DMA_ID_UPDATE];
+    DMA_HandleTypeDef* hdmaARR = hTimerSwitch[0]->hdma[TIM_DMA_ID_CC3];
 
-    // Seteo de la prioridad del timer 3 a la prioridad mas alta (0)
-    HAL_NVIC_SetPriority(TIM3_IRQn, 0, 0);
-    HAL_NVIC_EnableIRQ(TIM3_IRQn);
+    // Intervalo previo de SVM_DMA_MIN_TICKS: durante este el DMA de CC3 carga la duracion
+    // del primer intervalo y en su desborde el DMA de update escribe el primer BSRR
+    __HAL_TIM_SET_AUTORELOAD(hTimerSwitch[0], SVM_DMA_MIN_TICKS - 1);
+    __HAL_TIM_SET_COMPARE(hTimerSwitch[0], TIM_CHANNEL_3, 1);
+    __HAL_TIM_SET_COUNTER(hTimerSwitch[0], 0);
+    hTimerSwitch[0]->Instance->EGR = TIM_EGR_UG;
+    __HAL_TIM_CLEAR_FLAG(hTimerSwitch[0], TIM_FLAG_UPDATE);
 
-    // Se inician el timer 2
-    HAL_TIM_IC_Start_IT(hTimerCalc, TIM_CHANNEL_1);
+    hdmaBSRR->XferHalfCpltCallback = GestorTimers_DMAMitadCallback;
+    hdmaBSRR->XferCpltCallback = GestorTimers_DMACompletoCallback;
+    HAL_DMA_Start_IT(hdmaBSRR, (uint32_t)palabrasBSRR, (uint32_t)&GPIOA->BSRR, largo);
+    HAL_DMA_Start(hdmaARR, (uint32_t)duracionesARR, (uint32_t)&hTimerSwitch[0]->Instance->ARR, largo);
 
-    // Se inician los 4 canales del timer 3
-    HAL_TIM_IC_Start_IT(hTimerSwitch, TIM_CHANNEL_1);
-    HAL_TIM_IC_Start_IT(hTimerSwitch, TIM_CHANNEL_2);
-    HAL_TIM_IC_Start_IT(hTimerSwitch, TIM_CHANNEL_3);
-    HAL_TIM_IC_Start_IT(hTimerSwitch, TIM_CHANNEL_4);
+    __HAL_TIM_ENABLE_DMA(hTimerSwitch[0], TIM_DMA_UPDATE);
+    __HAL_TIM_ENABLE_DMA(hTimerSwitch[0], TIM_DMA_CC3);
+    __HAL_TIM_ENABLE(hTimerSwitch[0]);
 }
+#endif
 
-void GestorTimers_DetenerTimerSVM() {
+void GestorTimers_IniciarTimerSVM(int puente) {
+    TIM_HandleTypeDef* hTimer = hTimerSwitch[puente];
+#if SVM_CANTIDAD_PUENTES > 1
+    int otro;
+#endif
 
+    if (puentesActivos == 0) {
+        // Seteo de la prioridad del timer 2 a la segunda mas alta (1)
+        HAL_NVIC_SetPriority(TIM2_IRQn, 1, 0);
+        HAL_NVIC_EnableIRQ(TIM2_IRQn);
+
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+        // Seteo de la prioridad del update del timer 1 a la prioridad mas alta (0)
+        HAL_NVIC_SetPriority(TIM1_UP_IRQn, 0, 0);
+        HAL_NVIC_EnableIRQ(TIM1_UP_IRQn);
+#else
+        // Seteo de la prioridad del timer 3 a la prioridad mas alta (0)
+        HAL_NVIC_SetPriority(TIM3_IRQn, 0, 0);
+        HAL_NVIC_EnableIRQ(TIM3_IRQn);
+#if SVM_CANTIDAD_PUENTES > 1
+        HAL_NVIC_SetPriority(TIM4_IRQn, 0, 0);
+        HAL_NVIC_EnableIRQ(TIM4_IRQn);
+#endif
+#endif
+
+        // Se inicia el timer 2 antes que el de switching. Su primer calculo llega a los SVM_CALC_DESFASE_TICKS
+        // (el buffer ya esta precargado) y desde el primer update del timer de switching queda enganchado a su fase
+        __HAL_TIM_SET_COUNTER(hTimerCalc, 0);
+        HAL_TIM_IC_Start_IT(hTimerCalc, TIM_CHANNEL_1);
+
+#if SVM_CANTIDAD_PUENTES > 1
+        // Los timers de los demas puentes arrancan junto al pico (ARR - 1 contando hacia arriba): sus valles caen en
+        // los picos de este y los flancos de los dos puentes se intercalan. TIM2 se dispara en valle y pico de TIM3,
+        // asi que calcula en la misma fase para todos. Sin canales habilitados solo cuentan
+        for (otro = 0; otro < SVM_CANTIDAD_PUENTES; otro++) {
+            if (otro != puente) {
+                __HAL_TIM_SET_COUNTER(hTimerSwitch[otro], __HAL_TIM_GET_AUTORELOAD(hTimerSwitch[otro]) - 1);
+                __HAL_TIM_ENABLE(hTimerSwitch[otro]);
+            }
+        }
+#endif
+    } else {
+        // El contador ya corre para otro puente: las comparaciones anteriores al arranque no se atienden
+        __HAL_TIM_CLEAR_FLAG(hTimer, TIM_FLAG_CC1 | TIM_FLAG_CC2 | TIM_FLAG_CC3);
+    }
+    puentesActivos |= 1UL << puente;
+
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+    // El UG pasa a los registros activos los CCR ya precargados y reinicia el
+    // contador de repeticion, asi el update queda en el valle del contador
+    __HAL_TIM_SET_COUNTER(hTimer, 0);
+    hTimer->Instance->EGR = TIM_EGR_UG;
+    __HAL_TIM_CLEAR_FLAG(hTimer, TIM_FLAG_UPDATE);
+    __HAL_TIM_ENABLE_IT(hTimer, TIM_IT_UPDATE);
+
+    // Se inician los 3 canales del timer 1 (y sus complementarios)
+    HAL_TIM_PWM_Start(hTimer, TIM_CHANNEL_1);
+    HAL_TIM_PWM_Start(hTimer, TIM_CHANNEL_2);
+    HAL_TIM_PWM_Start(hTimer, TIM_CHANNEL_3);
+#if SVM_TIM1_COMPLEMENTARIAS
+    HAL_TIMEx_PWMN_Start(hTimer, TIM_CHANNEL_1);
+    HAL_TIMEx_PWMN_Start(hTimer, TIM_CHANNEL_2);
+    HAL_TIMEx_PWMN_Start(hTimer, TIM_CHANNEL_3);
+#endif
+#else
+    // Se inician los canales del timer del puente: CH1 (valle), CH2 (flancos) y CH3 (pico, con muestreo doble)
+    HAL_TIM_IC_Start_IT(hTimer, TIM_CHANNEL_1);
+    HAL_TIM_IC_Start_IT(hTimer, TIM_CHANNEL_2);
+#if SVM_MUESTREO_DOBLE
+    HAL_TIM_IC_Start_IT(hTimer, TIM_CHANNEL_3);
+#endif
+#if SVM_CORRIENTE_SHUNT
+    // CH4 sin interrupcion: su compare dispara las conversiones inyectadas del shunt
+    HAL_TIM_OC_Start(hTimer, TIM_CHANNEL_4);
+#endif
+#endif
+}
+
+void GestorTimers_DetenerTimerSVM(int puente) {
+    TIM_HandleTypeDef* hTimer = hTimerSwitch[puente];
+#if SVM_CANTIDAD_PUENTES > 1
+    int otro;
+#endif
+
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+    // Se detiene el timer de switcheo y sus DMA
+    __HAL_TIM_DISABLE(hTimer);
+    __HAL_TIM_DISABLE_DMA(hTimer, TIM_DMA_UPDATE);
+    __HAL_TIM_DISABLE_DMA(hTimer, TIM_DMA_CC3);
+    HAL_DMA_Abort(hTimer->hdma[TIM_DMA_ID_UPDATE]);
+    HAL_DMA_Abort(hTimer->hdma[TIM_DMA_ID_CC3]);
+#elif SVM_SALIDA == SVM_SALIDA_TIM1
+    // Se detiene el timer de switcheo. Al apagar el ultimo canal la HAL baja MOE
+    // y detiene el contador
+    __HAL_TIM_DISABLE_IT(hTimer, TIM_IT_UPDATE);
+#if SVM_TIM1_COMPLEMENTARIAS
+    HAL_TIMEx_PWMN_Stop(hTimer, TIM_CHANNEL_1);
+    HAL_TIMEx_PWMN_Stop(hTimer, TIM_CHANNEL_2);
+    HAL_TIMEx_PWMN_Stop(hTimer, TIM_CHANNEL_3);
+#endif
+    HAL_TIM_PWM_Stop(hTimer, TIM_CHANNEL_1);
+    HAL_TIM_PWM_Stop(hTimer, TIM_CHANNEL_2);
+    HAL_TIM_PWM_Stop(hTimer, TIM_CHANNEL_3);
+#else
     // Se detiene el timer de switcheo
-    HAL_TIM_IC_Stop_IT(hTimerSwitch, TIM_CHANNEL_1);
-    HAL_TIM_IC_Stop_IT(hTimerSwitch, TIM_CHANNEL_2);
-    HAL_TIM_IC_Stop_IT(hTimerSwitch, TIM_CHANNEL_3);
-    HAL_TIM_IC_Stop_IT(hTimerSwitch, TIM_CHANNEL_4);
-    
-    __HAL_TIM_SET_COUNTER(hTimerSwitch, 0);
+    HAL_TIM_IC_Stop_IT(hTimer, TIM_CHANNEL_1);
+    HAL_TIM_IC_Stop_IT(hTimer, TIM_CHANNEL_2);
+#if SVM_MUESTREO_DOBLE
+    HAL_TIM_IC_Stop_IT(hTimer, TIM_CHANNEL_3);
+#endif
+#if SVM_CORRIENTE_SHUNT
+    HAL_TIM_OC_Stop(hTimer, TIM_CHANNEL_4);
+#endif
+#endif
+    puentesActivos &= ~(1UL << puente);
+
+#if SVM_CANTIDAD_PUENTES > 1
+    // Otro puente sigue en marcha: el contador se vuelve a habilitar (la HAL lo detiene con el ultimo canal) para
+    // no correr su fase ni la de TIM2
+    if (puentesActivos != 0) {
+        __HAL_TIM_ENABLE(hTimer);
+        return;
+    }
+
+    for (otro = 0; otro < SVM_CANTIDAD_PUENTES; otro++) {
+        __HAL_TIM_DISABLE(hTimerSwitch[otro]);
+        __HAL_TIM_SET_COUNTER(hTimerSwitch[otro], 0);
+    }
+#else
+    __HAL_TIM_SET_COUNTER(hTimer, 0);
+#endif
     
     
     // Se detiene el timer de calculo
     HAL_TIM_IC_Stop_IT(hTimerCalc, TIM_CHANNEL_1);
     __HAL_TIM_SET_COUNTER(hTimerCalc, 0);
     
-}
\ No newline at end of file
+}
@@ -8,6 +8,8 @@
 #ifndef GESTOR_TIMERS_GESTORTIMERS_H_
 #define GESTOR_TIMERS_GESTORTIMERS_H_
 
+#include <stdint.h>
+#include "../Inc/main.h"
 
 
 typedef enum {
@@ -17,7 +19,16 @@ typedef enum {
 
 void GestorTimers_Init();
 
-void GestorTimers_IniciarTimerSVM();
-void GestorTimers_DetenerTimerSVM();
+// Timer de switching de un puente adicional (SVM_CANTIDAD_PUENTES > 1). El del puente 0 lo recibe GestorTimers_Init
+void GestorTimers_InitPuente(int puente, TIM_HandleTypeDef* _hTimerSwitch);
+
+void GestorTimers_IniciarTimerSVM(int puente);
+void GestorTimers_DetenerTimerSVM(int puente);
+
+// Carga el periodo del timer de switching (ARR center-aligned). El timer de calculo lo sigue por su TRGO
+void GestorTimers_ConfigurarPeriodo(int puente, int ticksPeriodo);
+
+// Inicio de TIM3 como contador de intervalos con DMA a BSRR y ARR (SVM_SALIDA_GPIO_DMA)
+void GestorTimers_IniciarTimerSVMDMA(uint32_t* palabrasBSRR, uint16_t* duracionesARR, int largo);
 
 #endif /* GESTOR_TIMERS_GESTORTIMERS_H_ */
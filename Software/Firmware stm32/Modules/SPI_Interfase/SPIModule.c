@@ -8,7 +8,9 @@
 #include <stdio.h>
 #include <string.h>
 #include "main.h"
+#include "SPIModule.h"
 #include "../Gestor_Estados/GestorEstados.h"
+#include "../Gestor_SVM/GestorSVM.h"
 
 /* Tamaños de buffers y frame SPI */
 #define SPI_BUF_SIZE           16   // Tamaño del buffer circular DMA RX/TX
@@ -38,11 +40,13 @@ SPI_HandleTypeDef* hspi;
  *                       escribe la respuesta en formato [RESP][';'][dato1][dato2].
  *
  * @note La respuesta se deja en bufferResponse; el callback de DMA la copiará a txDMABuffer.
- * @note Para GET_FREC se empaquetan hasta 2 bytes (valor <= 511 según tu lógica actual).
+ * @note SET_FREC y GET_FREC llevan la frecuencia en 16 bits, byte alto primero, en centésimas de Hz (hasta 655.35 Hz).
  */
 static void SPI_ProcesarComando(uint8_t* buffer, int cantBytes, uint8_t* bufferResponse) {
     int resp;
     int val;
+    PerfilSVM perfil;
+    uint32_t campo;
 
     // Selección por comando (primer byte del buffer de respuesta
     bufferResponse[0] = '\0';
@@ -84,7 +88,8 @@ static void SPI_ProcesarComando(uint8_t* buffer, int cantBytes, uint8_t* bufferR
             return;
 
         case SPI_REQUEST_SET_FREC:
-            val = (uint8_t)buffer[1] + (uint8_t)buffer[2];
+            /* 16 bits en centésimas de Hz (FREC_RESOLUCION), byte alto primero */
+            val = ((uint8_t)buffer[1] << 8) | (uint8_t)buffer[2];
             resp = GestorEstados_Action(ACTION_SET_FREC, val);
             
             if(resp == ACTION_RESP_OK) {
@@ -149,18 +154,121 @@ static void SPI_ProcesarComando(uint8_t* buffer, int cantBytes, uint8_t* bufferR
             bufferResponse[1] = ';';
             return;
 
+        case SPI_REQUEST_SET_FREC_SWITCH:
+            /* 16 bits: byte alto primero */
+            val = ((uint8_t)buffer[1] << 8) | (uint8_t)buffer[2];
+            resp = GestorEstados_Action(ACTION_SET_FREC_SWITCH, val);
+
+            if(resp == ACTION_RESP_OK) {
+                bufferResponse[0] = SPI_RESPONSE_OK;
+            } else if(resp == ACTION_RESP_OUT_RANGE) {
+                bufferResponse[0] = SPI_RESPONSE_ERR_DATA_OUT_RANGE;
+            } else if(resp == ACTION_RESP_MOVING) {
+                bufferResponse[0] = SPI_RESPONSE_ERR_MOVING;
+            } else {
+                bufferResponse[0] = SPI_RESPONSE_ERR;
+            }
+
+            bufferResponse[1] = ';';
+            return;
+
+        case SPI_REQUEST_GET_FREC_SWITCH:
+            val = GestorSVM_GetFrecuenciaSwitching();
+            bufferResponse[0] = SPI_RESPONSE_OK;
+            bufferResponse[1] = (uint8_t)(val >> 8);
+            bufferResponse[2] = (uint8_t)val;
+            bufferResponse[3] = ';';
+            return;
+
+        case SPI_REQUEST_SET_MODULADOR:
+            resp = GestorEstados_Action(ACTION_SET_MODULADOR, (uint8_t)buffer[1]);
+
+            if(resp == ACTION_RESP_OK) {
+                bufferResponse[0] = SPI_RESPONSE_OK;
+            } else if(resp == ACTION_RESP_OUT_RANGE) {
+                bufferResponse[0] = SPI_RESPONSE_ERR_DATA_OUT_RANGE;
+            } else {
+                bufferResponse[0] = SPI_RESPONSE_ERR;
+            }
+
+            bufferResponse[1] = ';';
+            return;
+
+        case SPI_REQUEST_GET_MODULADOR:
+            bufferResponse[0] = SPI_RESPONSE_OK;
+            bufferResponse[1] = (uint8_t)GestorSVM_GetModulador();
+            bufferResponse[2] = 0;
+            bufferResponse[3] = ';';
+            return;
+
+        case SPI_REQUEST_SET_VBUS:
+            /* 16 bits en V, byte alto primero */
+            val = ((uint8_t)buffer[1] << 8) | (uint8_t)buffer[2];
+            resp = GestorEstados_Action(ACTION_SET_VBUS, val);
+
+            if(resp == ACTION_RESP_OK) {
+                bufferResponse[0] = SPI_RESPONSE_OK;
+            } else if(resp == ACTION_RESP_OUT_RANGE) {
+                bufferResponse[0] = SPI_RESPONSE_ERR_DATA_OUT_RANGE;
+            } else {
+                bufferResponse[0] = SPI_RESPONSE_ERR;
+            }
+
+            bufferResponse[1] = ';';
+            return;
+
+        case SPI_REQUEST_GET_VBUS:
+            val = GestorSVM_GetTensionBus();
+            bufferResponse[0] = SPI_RESPONSE_OK;
+            bufferResponse[1] = (uint8_t)(val >> 8);
+            bufferResponse[2] = (uint8_t)val;
+            bufferResponse[3] = ';';
+            return;
+
+        case SPI_REQUEST_RESET_PERFIL:
+            bufferResponse[0] = (GestorSVM_ResetPerfil() == 0) ? SPI_RESPONSE_OK : SPI_RESPONSE_ERR;
+            bufferResponse[1] = ';';
+            return;
+
+        case SPI_REQUEST_GET_PERFIL:
+            /* Camino en el byte 1 y campo en el byte 2 */
+            resp = GestorSVM_GetPerfil((uint8_t)buffer[1], &perfil);
+
+            if(resp == -1 || buffer[2] >= SPI_PERFIL_CAMPO_HISTOGRAMA + PERFIL_SVM_CUBETAS) {
+                bufferResponse[0] = SPI_RESPONSE_ERR_DATA_OUT_RANGE;
+                bufferResponse[1] = ';';
+                return;
+            } else if(resp != 0) {
+                bufferResponse[0] = SPI_RESPONSE_ERR;
+                bufferResponse[1] = ';';
+                return;
+            }
+
+            switch (buffer[2]) {
+                case SPI_PERFIL_CAMPO_CANTIDAD: campo = perfil.cantidad; break;
+                case SPI_PERFIL_CAMPO_MINIMO:   campo = perfil.minimo;   break;
+                case SPI_PERFIL_CAMPO_MAXIMO:   campo = perfil.maximo;   break;
+                case SPI_PERFIL_CAMPO_MEDIA:    campo = perfil.media;    break;
+                default: campo = perfil.histograma[buffer[2] - SPI_PERFIL_CAMPO_HISTOGRAMA]; break;
+            }
+            if (campo > 0xFFFF) {
+                campo = 0xFFFF;
+            }
+
+            /* 16 bits, byte alto primero */
+            bufferResponse[0] = SPI_RESPONSE_OK;
+            bufferResponse[1] = (uint8_t)(campo >> 8);
+            bufferResponse[2] = (uint8_t)campo;
+            bufferResponse[3] = ';';
+            return;
+
         case SPI_REQUEST_GET_FREC:
             /* Lee valor actual de frecuencia desde el SVM */
             val = GestorSVM_GetFrec();
             bufferResponse[0] = SPI_RESPONSE_OK;
-            /* Empaquetado simple en 2 bytes (LOW/HIGH “capado”) */
-            if (val > 255) {
-                bufferResponse[1] = 255;
-                bufferResponse[2] = (uint8_t)(val - 255);
-            } else {
-                bufferResponse[1] = (uint8_t)val;
-                bufferResponse[2] = 0;
-            }
+            /* 16 bits en centésimas de Hz, byte alto primero */
+            bufferResponse[1] = (uint8_t)(val >> 8);
+            bufferResponse[2] = (uint8_t)val;
             bufferResponse[3] = ';';
             return;
 
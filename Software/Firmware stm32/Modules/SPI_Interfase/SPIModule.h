@@ -30,19 +30,41 @@
 typedef enum {
     SPI_REQUEST_START       = 10,   /** Solicita arranque → equivale a @ref ACTION_START. */
     SPI_REQUEST_STOP,               /** Solicita parada → equivale a @ref ACTION_STOP. */
-    SPI_REQUEST_SET_FREC,           /** Setea frecuencia de régimen → @ref ACTION_SET_FREC (requiere datos). */
+    SPI_REQUEST_SET_FREC,           /** Setea frecuencia de régimen [0.01 Hz] → @ref ACTION_SET_FREC (16 bits, byte alto primero). */
     SPI_REQUEST_SET_ACEL,           /** Setea aceleración → @ref ACTION_SET_ACEL (requiere datos). */
     SPI_REQUEST_SET_DESACEL,        /** Setea desaceleración → @ref ACTION_SET_DESACEL (requiere datos). */
     SPI_REQUEST_SET_DIR,            /** Setea dirección de giro → @ref ACTION_SET_DIR (requiere datos). */
-    SPI_REQUEST_GET_FREC,           /** Consulta frecuencia actual → lectura sin cambio de @ref SystemState. */
+    SPI_REQUEST_GET_FREC,           /** Consulta frecuencia de referencia [0.01 Hz] (16 bits, byte alto primero). */
     SPI_REQUEST_GET_ACEL,           /** Consulta aceleración actual. */
     SPI_REQUEST_GET_DESACEL,        /** Consulta desaceleración actual. */
     SPI_REQUEST_GET_DIR,            /** Consulta dirección actual. */
     SPI_REQUEST_IS_STOP,            /** Consulta si el motor está detenido → usa @ref ACTION_IS_MOTOR_STOP. */
     SPI_REQUEST_EMERGENCY,          /** Fuerza emergencia → @ref ACTION_EMERGENCY. */
+    SPI_REQUEST_SET_FREC_SWITCH,    /** Setea frecuencia de switching [Hz] → @ref ACTION_SET_FREC_SWITCH (16 bits, byte alto primero). */
+    SPI_REQUEST_GET_FREC_SWITCH,    /** Consulta frecuencia de switching efectiva [Hz] (16 bits, byte alto primero). */
+    SPI_REQUEST_SET_MODULADOR,      /** Selecciona el modulador (0 SVPWM, 1 SPWM, 2 THIPWM) → @ref ACTION_SET_MODULADOR. */
+    SPI_REQUEST_GET_MODULADOR,      /** Consulta el modulador actual. */
+    SPI_REQUEST_SET_VBUS,           /** Informa la tensión del bus medida por el ESP32 [V] → @ref ACTION_SET_VBUS (16 bits, byte alto primero). */
+    SPI_REQUEST_GET_VBUS,           /** Consulta la tensión del bus filtrada con la que se compensa la modulación [V] (16 bits, byte alto primero). */
+    SPI_REQUEST_RESET_PERFIL,       /** Reinicia las mediciones de ciclos de las interrupciones del SVM (requiere @ref SVM_PERFIL). */
+    SPI_REQUEST_GET_PERFIL,         /** Consulta un campo (@ref SPI_PerfilCampo) de la medición de un camino (@ref CaminoPerfilSVM): `CMD camino campo ';'` (16 bits, byte alto primero). */
     SPI_REQUEST_RESPONSE    = 0x50  /** Ping/placeholder para obtener la última respuesta. */
 } SPI_Request;
 
+/**
+ * @enum SPI_PerfilCampo
+ * @brief Campo de @ref PerfilSVM que devuelve @ref SPI_REQUEST_GET_PERFIL.
+ * @details Los valores mayores a 0xFFFF se saturan. La cubeta k del histograma es el campo
+ *          @ref SPI_PERFIL_CAMPO_HISTOGRAMA + k.
+ */
+typedef enum {
+    SPI_PERFIL_CAMPO_CANTIDAD = 0,  /** Ejecuciones medidas. */
+    SPI_PERFIL_CAMPO_MINIMO,        /** Menor duración [ciclos]. */
+    SPI_PERFIL_CAMPO_MAXIMO,        /** Mayor duración [ciclos]. */
+    SPI_PERFIL_CAMPO_MEDIA,         /** Duración media [ciclos]. */
+    SPI_PERFIL_CAMPO_HISTOGRAMA     /** Primera cubeta del histograma. */
+} SPI_PerfilCampo;
+
 /**
  * @enum SPI_Response
  * @brief Códigos de respuesta emitidos por el esclavo STM32.
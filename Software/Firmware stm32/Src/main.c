@@ -2,7 +2,7 @@
  * @file main.c
  * @brief Punto de entrada del firmware y configuración de periféricos.
  * @details Inicializa reloj de sistema, GPIO, DMA, SPI2 (esclavo), USART1 (debug),
- *          y TIM2/TIM3 (cálculo y switching). Integra módulos GestorSVM, GestorTimers,
+ *          y TIM2/TIM3 (cálculo y switching; TIM1 para el switching con @ref SVM_SALIDA_TIM1). Integra módulos GestorSVM, GestorTimers,
  *          GestorEstados y SPI module.
  *   Disposicion de transistores, los transistores
  *   son los Q1, Q2, Q3, Q4, Q5 y Q6 
@@ -42,8 +42,20 @@
 SPI_HandleTypeDef hspi2;
 DMA_HandleTypeDef hdma_spi2_tx;
 DMA_HandleTypeDef hdma_spi2_rx;
+DMA_HandleTypeDef hdma_tim3_up;
+DMA_HandleTypeDef hdma_tim3_ch3;
+TIM_HandleTypeDef htim1;
 TIM_HandleTypeDef htim2;
 TIM_HandleTypeDef htim3;
+#if SVM_CANTIDAD_PUENTES > 1
+TIM_HandleTypeDef htim4;
+#endif
+#if SVM_CORRIENTE_SHUNT
+ADC_HandleTypeDef hadc1;
+#endif
+#if SVM_VBUS_FUENTE == SVM_VBUS_ADC
+ADC_HandleTypeDef hadc2;
+#endif
 UART_HandleTypeDef huart1;
 
 /**
@@ -51,6 +63,7 @@ UART_HandleTypeDef huart1;
  * @brief Configura el clock del sistema a 72 MHz desde HSE=8 MHz con PLL×9.
  * @details Activa HSE, configura PLL (source=HSE, mul=×9) y selecciona SYSCLK=PLL.
  *          AHB=72 MHz, APB2=72 MHz (div1), APB1=36 MHz (div2), FLASH_LATENCY=2.
+ *          Con @ref SVM_CORRIENTE_SHUNT o @ref SVM_VBUS_ADC, ADC=12 MHz (APB2 div6, el máximo del ADC es 14 MHz).
  */
  static void SystemClock_Config(void);
 
@@ -66,7 +79,7 @@ static void MX_GPIO_Init(void);
 /**
  * @fn static void MX_DMA_Init(void)
  *
- * @brief Habilita el clock del DMA1 y sus interrupciones de canal 4 y 5.
+ * @brief Habilita el clock del DMA1 y sus interrupciones de canal 4 y 5 (y canal 3 con @ref SVM_SALIDA_GPIO_DMA).
  *
  * @details Habilita el reloj del **DMA1** y registra en el NVIC las IRQ de **DMA1_Channel4** y **DMA1_Channel5** con prioridad 2.
  * En F1, estos canales suelen mapearse a **SPI2_RX (Ch4)** y **SPI2_TX (Ch5)**, por lo que esta rutina deja listo el DMA para que llamadas como `HAL_SPI_TransmitReceive_DMA()` configuren y lancen las transferencias.  
@@ -80,16 +93,67 @@ static void MX_DMA_Init(void);
  * 
  * @brief Función inicialización del timer 3 (SVM)
  *
- * @details El timer 3 es utilizado para ejecutar el swtching de los pines del variador de frecuencia. Trabaja con un timer de 0 a 256 utilizando el clock interno como fuente de conteo dando un período de 398.22us (f = 2511Hz) y 4 canales de interrupción CCR1-4 que se irán corriendo conforme vaya avanzando la señal y cambiando la tensión de salida buscada de acuerdo a lo que dicte el estado del módulo SVM.
+ * @details El timer 3 es utilizado para ejecutar el swtching de los pines del variador de frecuencia. Trabaja en center-aligned sin prescaler (un tick = 1/@ref SVM_FREC_TIMER) de 0 a @ref SVM_FREC_TIMER / (2 · frecuencia de switching), 14337 para la frecuencia por defecto de 2511Hz; el período lo recalcula GestorSVM_SetFrecuenciaSwitching (y cada muestra en el valle, por eso sin precarga de ARR). CCR1 interrumpe en el valle y CCR2 recorre la tabla de flancos de cada período que entrega el módulo SVM; con @ref SVM_MUESTREO_DOBLE, CCR3 interrumpe en el pico.
+ * Con @ref SVM_SALIDA_GPIO_DMA cuenta en forma ascendente un intervalo por flanco: el DMA del update escribe BSRR y el del canal 3 la duración del intervalo siguiente.
  */
 static void MX_TIM3_Init(void);
 
+#if SVM_CANTIDAD_PUENTES > 1
+/**
+ * @fn  static void MX_TIM4_Init(void);
+ *
+ * @brief Función inicialización del timer 4 (switching del puente 1)
+ *
+ * @details Misma configuración que el timer 3 con @ref SVM_SALIDA_GPIO_ISR, pero sin TRGO: el timer de cálculo sigue a TIM3.
+ * GestorTimers lo arranca medio período corrido respecto de TIM3.
+ */
+static void MX_TIM4_Init(void);
+#endif
+
+#if SVM_CORRIENTE_SHUNT
+/**
+ * @fn  static void MX_ADC1_Init(void);
+ *
+ * @brief Función inicialización del ADC1 (shunt del bus, @ref SVM_CORRIENTE_SHUNT)
+ *
+ * @details Una conversión inyectada de @ref GPIO_SHUNT (canal 0) por cada compare del canal 4 de TIM3, con 7.5 ciclos de muestreo: 1.7 µs por
+ * conversión a 12 MHz. El fin de conversión interrumpe con la misma prioridad que TIM3 y el módulo SVM lleva el CC4 al vector activo siguiente.
+ * El grupo regular no se usa.
+ */
+static void MX_ADC1_Init(void);
+#endif
+
+#if SVM_VBUS_FUENTE == SVM_VBUS_ADC
+/**
+ * @fn  static void MX_ADC2_Init(void);
+ *
+ * @brief Función inicialización del ADC2 (tensión del bus, @ref SVM_VBUS_ADC)
+ *
+ * @details Conversión regular continua de @ref GPIO_VBUS (canal 7) con 239.5 ciclos de muestreo, por la impedancia del divisor: una conversión
+ * cada 21 µs a 12 MHz. Sin interrupciones ni DMA: el productor del módulo SVM lee el DR una vez por interrupción.
+ */
+static void MX_ADC2_Init(void);
+#endif
+
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+/**
+ * @fn  static void MX_TIM1_Init(void);
+ *
+ * @brief Función inicialización del timer 1 (SVM con @ref SVM_SALIDA_TIM1)
+ *
+ * @details Misma base de tiempo que el timer 3 (sin prescaler, center-aligned, período dado por la frecuencia de switching). Los canales 1 a 3 en PWM2
+ * generan las fases U, V y W con sus complementarias y el tiempo muerto @ref SVM_TIM1_TIEMPO_MUERTO por hardware. El contador
+ * de repetición en 1 deja un único update por período, en el valle, donde se cargan los CCR precargados.
+ */
+static void MX_TIM1_Init(void);
+#endif
+
 /**
   * @fn static void MX_TIM2_Init(void);
   * 
   * @brief Función de inicialización del timer 2 (Pre cálculo)
   *
-  * @details El timer funcionará a 10KHz tratando de adelantar los cálculos del timer 3, permitiendo agilizar la carga de sus contadores y evitando que haya problemas en la señal de salida.
+  * @details Esclavo en modo reset del timer de switching: el TRGO del update de TIM3 (ITR2) o de TIM1 (ITR0, con @ref SVM_SALIDA_TIM1) pone el contador en 0 y CCR1 interrumpe @ref SVM_CALC_DESFASE_TICKS después, siempre en la misma fase de la portadora. El ARR queda en 0xFFFF para que no desborde entre dos updates (a lo sumo un período de switching, 48000 ticks a @ref FREC_SWITCH_MINIMA). Con @ref SVM_SALIDA_GPIO_DMA no se usa.
   */
 static void MX_TIM2_Init(void);
 
@@ -120,9 +184,9 @@ static void MX_SPI2_Init(void);
  * La función main inicializa la estructura de configuración, inicializa los periféricos y el gestor de estados. Al terminar su trabajo queda en un while(1) con la sentencia WFI para reducir el consumo de CPU.
  *   1) HAL_Init()
  *   2) SystemClock_Config()
- *   3) Carga configuración SVM (frecuencia de switching, ref, etc.).
+ *   3) Inicializa periféricos (GPIO, DMA, TIM3, USART1, TIM2, SPI2) y driver SPI.
  *   4) Inicializa manejador de timers (GestorTimers_Init).
- *   5) Inicializa periféricos (GPIO, DMA, TIM3, USART1, TIM2, SPI2) y driver SPI.
+ *   5) Carga configuración SVM (frecuencia de switching, ref, etc.), que ajusta los períodos de los timers.
  *   6) Notifica fin de init al Gestor de Estados (ACTION_INIT_DONE).
  *   7) Entra en lazo con WFI para ahorrar CPU, atendiendo a interrupciones.
  *
@@ -136,33 +200,65 @@ int main(void) {
  
   
   ConfiguracionSVM config = {                   /// Cofiguración del módulo SVM
-    .frec_switch = 2511,                        /// Frecuencia de 2.511kHz para el switch del timer 3 entre subida y bajada del timer 3
+    .frec_switch = FREC_SWITCH,                 /// Frecuencia de 2.511kHz para el switch del timer 3 entre subida y bajada del timer 3
     .frecReferencia = 50,                       /// Frecuencia de salida
     .direccionRotacion = 1,                     /// Sentido horario
     .acel = 5,                                  /// Aceleracón del sistema por default [Hz/seg]
     .desacel = 3,                               /// Desaceleracón del sistema por default [Hz/seg]
   };
-  
-  // Cargamos los numeros de los pines
-  config.puerto_senal_pierna[0] = GPIO_PIN_1;
-  config.puerto_senal_pierna[1] = GPIO_PIN_3;
-  config.puerto_senal_pierna[2] = GPIO_PIN_5;
-  config.puerto_encen_pierna[0] = GPIO_PIN_2;
-  config.puerto_encen_pierna[1] = GPIO_PIN_4;
-  config.puerto_encen_pierna[2] = GPIO_PIN_6;
-  GestorSVM_SetConfiguration(&config);
 
   // Initialize all configured peripherals
   MX_GPIO_Init();
   MX_DMA_Init();
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+  MX_TIM1_Init();
+#else
   MX_TIM3_Init();
+#endif
+#if SVM_CANTIDAD_PUENTES > 1
+  MX_TIM4_Init();
+#endif
+#if SVM_CORRIENTE_SHUNT
+  MX_ADC1_Init();
+#endif
+#if SVM_VBUS_FUENTE == SVM_VBUS_ADC
+  MX_ADC2_Init();
+#endif
   MX_TIM2_Init();
   MX_USART1_UART_Init();
   MX_SPI2_Init();
   SPI_Init(&hspi2);
 
   // Inicio del gestor de timers
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+  GestorTimers_Init(&htim1, &htim2);
+#else
   GestorTimers_Init(&htim3, &htim2);
+#endif
+#if SVM_CANTIDAD_PUENTES > 1
+  GestorTimers_InitPuente(1, &htim4);
+#endif
+#if SVM_CORRIENTE_SHUNT
+  // Calibracion con el ADC en reposo y disparo externo habilitado: convierte solo cuando el CC4 de TIM3 lo pide
+  if (HAL_ADCEx_Calibration_Start(&hadc1) != HAL_OK || HAL_ADCEx_InjectedStart_IT(&hadc1) != HAL_OK) {
+    Error_Handler();
+  }
+#endif
+#if SVM_VBUS_FUENTE == SVM_VBUS_ADC
+  // Conversion continua desde el arranque: el filtro del bus ya tiene la tension cuando arranca el motor
+  if (HAL_ADCEx_Calibration_Start(&hadc2) != HAL_OK || HAL_ADC_Start(&hadc2) != HAL_OK) {
+    Error_Handler();
+  }
+#endif
+
+  // La configuracion SVM carga los periodos de los timers, por eso va despues de su inicio
+  GestorSVM_SetConfiguration(&config);
+#if SVM_CANTIDAD_PUENTES > 1
+  // El puente 1 arranca con la misma configuracion; el gestor de estados maneja el puente 0
+  GestorSVM_SeleccionarPuente(1);
+  GestorSVM_SetConfiguration(&config);
+  GestorSVM_SeleccionarPuente(0);
+#endif
 
   // Informamos al gestor de estados que finalizo la inicializacion
   // Esta debe ser la ultima llama de funcion del init
@@ -171,6 +267,12 @@ int main(void) {
 
   __HAL_DBGMCU_FREEZE_TIM3();
   __HAL_DBGMCU_FREEZE_TIM2();
+#if SVM_CANTIDAD_PUENTES > 1
+  __HAL_DBGMCU_FREEZE_TIM4();
+#endif
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+  __HAL_DBGMCU_FREEZE_TIM1();
+#endif
 
   while (1) {
     __WFI();
@@ -180,6 +282,9 @@ int main(void) {
 static void SystemClock_Config(void) {
   RCC_OscInitTypeDef RCC_OscInitStruct = {0};
   RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+#if SVM_CORRIENTE_SHUNT || SVM_VBUS_FUENTE == SVM_VBUS_ADC
+  RCC_PeriphCLKInitTypeDef PeriphClkInit = {0};
+#endif
 
   // Initializes the RCC Oscillators according to the specified parameters in the RCC_OscInitTypeDef structure.
   RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
@@ -203,6 +308,14 @@ static void SystemClock_Config(void) {
   if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK) {
     Error_Handler();
   }
+
+#if SVM_CORRIENTE_SHUNT || SVM_VBUS_FUENTE == SVM_VBUS_ADC
+  PeriphClkInit.PeriphClockSelection = RCC_PERIPHCLK_ADC;
+  PeriphClkInit.AdcClockSelection = RCC_ADCPCLK2_DIV6;
+  if (HAL_RCCEx_PeriphCLKConfig(&PeriphClkInit) != HAL_OK) {
+    Error_Handler();
+  }
+#endif
 }
 
 static void MX_SPI2_Init(void) {
@@ -225,13 +338,17 @@ static void MX_SPI2_Init(void) {
 static void MX_TIM2_Init(void) {
 
   TIM_ClockConfigTypeDef sClockSourceConfig = {0};
+#if SVM_SALIDA != SVM_SALIDA_GPIO_DMA
+  TIM_SlaveConfigTypeDef sSlaveConfig = {0};
+#endif
   TIM_MasterConfigTypeDef sMasterConfig = {0};
   TIM_OC_InitTypeDef sConfigOC = {0};
 
   htim2.Instance = TIM2;
   htim2.Init.Prescaler = 0;
   htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
-  htim2.Init.Period = 7199;
+  // El update del timer de switching lo reinicia antes de llegar al ARR
+  htim2.Init.Period = 0xFFFF;
   htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
   htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
   if (HAL_TIM_Base_Init(&htim2) != HAL_OK) {
@@ -246,6 +363,18 @@ static void MX_TIM2_Init(void) {
     Error_Handler();
   }
 
+#if SVM_SALIDA != SVM_SALIDA_GPIO_DMA
+  sSlaveConfig.SlaveMode = TIM_SLAVEMODE_RESET;
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+  sSlaveConfig.InputTrigger = TIM_TS_ITR0;
+#else
+  sSlaveConfig.InputTrigger = TIM_TS_ITR2;
+#endif
+  if (HAL_TIM_SlaveConfigSynchro(&htim2, &sSlaveConfig) != HAL_OK) {
+    Error_Handler();
+  }
+#endif
+
   sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
   sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
   if (HAL_TIMEx_MasterConfigSynchronization(&htim2, &sMasterConfig) != HAL_OK) {
@@ -253,7 +382,7 @@ static void MX_TIM2_Init(void) {
   }
 
   sConfigOC.OCMode = TIM_OCMODE_TIMING;
-  sConfigOC.Pulse = 5;
+  sConfigOC.Pulse = SVM_CALC_DESFASE_TICKS;
   sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
   sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
   if (HAL_TIM_OC_ConfigChannel(&htim2, &sConfigOC, TIM_CHANNEL_1) != HAL_OK) {
@@ -267,11 +396,22 @@ static void MX_TIM3_Init(void) {
   TIM_OC_InitTypeDef sConfigOC = {0};
 
   htim3.Instance = TIM3;
-  htim3.Init.Prescaler = 55;
+  htim3.Init.Prescaler = 0;
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+  // Contador de intervalos: el ARR de cada flanco lo carga el DMA de CC3
+  htim3.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim3.Init.Period = SVM_DMA_MIN_TICKS - 1;
+#else
   htim3.Init.CounterMode = TIM_COUNTERMODE_CENTERALIGNED3;
-  htim3.Init.Period = 256;
+  htim3.Init.Period = SVM_FREC_TIMER / 2 / FREC_SWITCH;
+#endif
   htim3.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+#if SVM_SALIDA == SVM_SALIDA_GPIO_ISR
+  // El RESET escribe el ARR en el valle y debe valer para el periodo que empieza
+  htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+#else
   htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+#endif
   if (HAL_TIM_Base_Init(&htim3) != HAL_OK) {
     Error_Handler();
   }
@@ -284,42 +424,241 @@ static void MX_TIM3_Init(void) {
     Error_Handler();
   }
 
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
   sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
+#else
+  // El update (valle y pico) reinicia el timer de calculo
+  sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+#endif
   sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
   if (HAL_TIMEx_MasterConfigSynchronization(&htim3, &sMasterConfig) != HAL_OK) {
     Error_Handler();
   }
 
   sConfigOC.OCMode = TIM_OCMODE_TIMING;
-  sConfigOC.Pulse = 0;
   sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
   sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+  // El compare del canal 3 en 1 dispara el DMA del ARR una vez por intervalo
+  sConfigOC.Pulse = 1;
+  if (HAL_TIM_OC_ConfigChannel(&htim3, &sConfigOC, TIM_CHANNEL_3) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#else
+  sConfigOC.Pulse = 0;
   if (HAL_TIM_OC_ConfigChannel(&htim3, &sConfigOC, TIM_CHANNEL_1) != HAL_OK)
   {
     Error_Handler();
   }
   __HAL_TIM_ENABLE_OCxPRELOAD(&htim3, TIM_CHANNEL_1);
-  sConfigOC.Pulse = 20;
+  // Canal de flancos: sin precarga, el ISR arma cada flanco con el siguiente de la tabla
+  sConfigOC.Pulse = 0xFFFF;
   if (HAL_TIM_OC_ConfigChannel(&htim3, &sConfigOC, TIM_CHANNEL_2) != HAL_OK)
   {
     Error_Handler();
   }
-  __HAL_TIM_ENABLE_OCxPRELOAD(&htim3, TIM_CHANNEL_2);
-  sConfigOC.Pulse = 80;
+#if SVM_MUESTREO_DOBLE
+  // Canal del pico: el RESET lo carga con el ARR de cada periodo
   if (HAL_TIM_OC_ConfigChannel(&htim3, &sConfigOC, TIM_CHANNEL_3) != HAL_OK)
   {
     Error_Handler();
   }
-  __HAL_TIM_ENABLE_OCxPRELOAD(&htim3, TIM_CHANNEL_3);
-  sConfigOC.Pulse = 240;
+#endif
+#if SVM_CORRIENTE_SHUNT
+  // Disparo del ADC: sin precarga, el RESET y el fin de cada conversion lo mueven dentro del periodo
   if (HAL_TIM_OC_ConfigChannel(&htim3, &sConfigOC, TIM_CHANNEL_4) != HAL_OK)
   {
     Error_Handler();
   }
-  __HAL_TIM_ENABLE_OCxPRELOAD(&htim3, TIM_CHANNEL_4);
+#endif
+#endif
 
 }
 
+#if SVM_CANTIDAD_PUENTES > 1
+static void MX_TIM4_Init(void) {
+  TIM_ClockConfigTypeDef sClockSourceConfig = {0};
+  TIM_MasterConfigTypeDef sMasterConfig = {0};
+  TIM_OC_InitTypeDef sConfigOC = {0};
+
+  htim4.Instance = TIM4;
+  htim4.Init.Prescaler = 0;
+  htim4.Init.CounterMode = TIM_COUNTERMODE_CENTERALIGNED3;
+  htim4.Init.Period = SVM_FREC_TIMER / 2 / FREC_SWITCH;
+  htim4.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim4.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  if (HAL_TIM_Base_Init(&htim4) != HAL_OK) {
+    Error_Handler();
+  }
+
+  sClockSourceConfig.ClockSource = TIM_CLOCKSOURCE_INTERNAL;
+  if (HAL_TIM_ConfigClockSource(&htim4, &sClockSourceConfig) != HAL_OK) {
+    Error_Handler();
+  }
+  if (HAL_TIM_OC_Init(&htim4) != HAL_OK) {
+    Error_Handler();
+  }
+
+  // El timer de calculo sigue solo a TIM3
+  sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
+  sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+  if (HAL_TIMEx_MasterConfigSynchronization(&htim4, &sMasterConfig) != HAL_OK) {
+    Error_Handler();
+  }
+
+  sConfigOC.OCMode = TIM_OCMODE_TIMING;
+  sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
+  sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+  sConfigOC.Pulse = 0;
+  if (HAL_TIM_OC_ConfigChannel(&htim4, &sConfigOC, TIM_CHANNEL_1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  __HAL_TIM_ENABLE_OCxPRELOAD(&htim4, TIM_CHANNEL_1);
+  sConfigOC.Pulse = 0xFFFF;
+  if (HAL_TIM_OC_ConfigChannel(&htim4, &sConfigOC, TIM_CHANNEL_2) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#if SVM_MUESTREO_DOBLE
+  if (HAL_TIM_OC_ConfigChannel(&htim4, &sConfigOC, TIM_CHANNEL_3) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#endif
+}
+#endif
+
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+static void MX_TIM1_Init(void) {
+  TIM_ClockConfigTypeDef sClockSourceConfig = {0};
+  TIM_MasterConfigTypeDef sMasterConfig = {0};
+  TIM_OC_InitTypeDef sConfigOC = {0};
+  TIM_BreakDeadTimeConfigTypeDef sBreakDeadTimeConfig = {0};
+
+  htim1.Instance = TIM1;
+  htim1.Init.Prescaler = 0;
+  htim1.Init.CounterMode = TIM_COUNTERMODE_CENTERALIGNED1;
+  htim1.Init.Period = SVM_FREC_TIMER / 2 / FREC_SWITCH;
+  htim1.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+#if SVM_MUESTREO_DOBLE
+  // Update en el valle y en el pico: cada mitad carga sus CCR
+  htim1.Init.RepetitionCounter = 0;
+#else
+  htim1.Init.RepetitionCounter = 1;
+#endif
+  htim1.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+  if (HAL_TIM_Base_Init(&htim1) != HAL_OK) {
+    Error_Handler();
+  }
+
+  sClockSourceConfig.ClockSource = TIM_CLOCKSOURCE_INTERNAL;
+  if (HAL_TIM_ConfigClockSource(&htim1, &sClockSourceConfig) != HAL_OK) {
+    Error_Handler();
+  }
+  if (HAL_TIM_PWM_Init(&htim1) != HAL_OK) {
+    Error_Handler();
+  }
+
+  // El update (solo en el valle con RCR = 1, valle y pico con muestreo doble) reinicia el timer de calculo
+  sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+  sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+  if (HAL_TIMEx_MasterConfigSynchronization(&htim1, &sMasterConfig) != HAL_OK) {
+    Error_Handler();
+  }
+
+  // Fase en alto mientras CNT >= CCR. Con CCR mayor al ARR la fase queda en bajo
+  sConfigOC.OCMode = TIM_OCMODE_PWM2;
+  sConfigOC.Pulse = 0xFFFF;
+  sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
+  sConfigOC.OCNPolarity = TIM_OCNPOLARITY_HIGH;
+  sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+  sConfigOC.OCIdleState = TIM_OCIDLESTATE_RESET;
+  sConfigOC.OCNIdleState = TIM_OCNIDLESTATE_RESET;
+  if (HAL_TIM_PWM_ConfigChannel(&htim1, &sConfigOC, TIM_CHANNEL_1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  if (HAL_TIM_PWM_ConfigChannel(&htim1, &sConfigOC, TIM_CHANNEL_2) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  if (HAL_TIM_PWM_ConfigChannel(&htim1, &sConfigOC, TIM_CHANNEL_3) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  sBreakDeadTimeConfig.OffStateRunMode = TIM_OSSR_DISABLE;
+  sBreakDeadTimeConfig.OffStateIDLEMode = TIM_OSSI_DISABLE;
+  sBreakDeadTimeConfig.LockLevel = TIM_LOCKLEVEL_OFF;
+  sBreakDeadTimeConfig.DeadTime = SVM_TIM1_TIEMPO_MUERTO;
+  sBreakDeadTimeConfig.BreakState = TIM_BREAK_DISABLE;
+  sBreakDeadTimeConfig.BreakPolarity = TIM_BREAKPOLARITY_HIGH;
+  sBreakDeadTimeConfig.AutomaticOutput = TIM_AUTOMATICOUTPUT_DISABLE;
+  if (HAL_TIMEx_ConfigBreakDeadTime(&htim1, &sBreakDeadTimeConfig) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  HAL_TIM_MspPostInit(&htim1);
+}
+#endif
+
+#if SVM_CORRIENTE_SHUNT
+static void MX_ADC1_Init(void) {
+  ADC_InjectionConfTypeDef sConfigInjected = {0};
+
+  hadc1.Instance = ADC1;
+  hadc1.Init.ScanConvMode = ADC_SCAN_DISABLE;
+  hadc1.Init.ContinuousConvMode = DISABLE;
+  hadc1.Init.DiscontinuousConvMode = DISABLE;
+  hadc1.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+  hadc1.Init.DataAlign = ADC_DATAALIGN_RIGHT;
+  hadc1.Init.NbrOfConversion = 1;
+  if (HAL_ADC_Init(&hadc1) != HAL_OK) {
+    Error_Handler();
+  }
+
+  // Un rango por disparo: cada conversion queda en JDR1 y el ISR la guarda antes de la siguiente
+  sConfigInjected.InjectedChannel = ADC_CHANNEL_0;
+  sConfigInjected.InjectedRank = ADC_INJECTED_RANK_1;
+  sConfigInjected.InjectedNbrOfConversion = 1;
+  sConfigInjected.InjectedSamplingTime = ADC_SAMPLETIME_7CYCLES_5;
+  sConfigInjected.ExternalTrigInjecConv = ADC_EXTERNALTRIGINJECCONV_T3_CC4;
+  sConfigInjected.AutoInjectedConv = DISABLE;
+  sConfigInjected.InjectedDiscontinuousConvMode = DISABLE;
+  sConfigInjected.InjectedOffset = 0;
+  if (HAL_ADCEx_InjectedConfigChannel(&hadc1, &sConfigInjected) != HAL_OK) {
+    Error_Handler();
+  }
+}
+#endif
+
+#if SVM_VBUS_FUENTE == SVM_VBUS_ADC
+static void MX_ADC2_Init(void) {
+  ADC_ChannelConfTypeDef sConfig = {0};
+
+  hadc2.Instance = ADC2;
+  hadc2.Init.ScanConvMode = ADC_SCAN_DISABLE;
+  hadc2.Init.ContinuousConvMode = ENABLE;
+  hadc2.Init.DiscontinuousConvMode = DISABLE;
+  hadc2.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+  hadc2.Init.DataAlign = ADC_DATAALIGN_RIGHT;
+  hadc2.Init.NbrOfConversion = 1;
+  if (HAL_ADC_Init(&hadc2) != HAL_OK) {
+    Error_Handler();
+  }
+
+  sConfig.Channel = ADC_CHANNEL_7;
+  sConfig.Rank = ADC_REGULAR_RANK_1;
+  sConfig.SamplingTime = ADC_SAMPLETIME_239CYCLES_5;
+  if (HAL_ADC_ConfigChannel(&hadc2, &sConfig) != HAL_OK) {
+    Error_Handler();
+  }
+}
+#endif
+
 static void MX_USART1_UART_Init(void) {
   huart1.Instance = USART1;
   huart1.Init.BaudRate = 115200;
@@ -340,6 +679,11 @@ static void MX_DMA_Init(void) {
   HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
   HAL_NVIC_SetPriority(DMA1_Channel5_IRQn, 2, 0);
   HAL_NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+  // Media transferencia / completa del DMA de BSRR: recalculo de la mitad consumida
+  HAL_NVIC_SetPriority(DMA1_Channel3_IRQn, 1, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+#endif
 }
 
 static void MX_GPIO_Init(void) {
@@ -364,6 +708,14 @@ static void MX_GPIO_Init(void) {
   GPIO_InitStruct.Pull = GPIO_NOPULL;
   GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
   HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+
+#if SVM_CANTIDAD_PUENTES > 1
+  // Puente 1: los mismos pines del puente 0 corridos SVM_PUENTE1_DESPLAZAMIENTO (PB3..PB8). PB3/PB4 quedan libres
+  // sin JTAG y PB6/PB7 porque USART1 pasa a PA9/PA10 (SVM_USART1_REMAP)
+  HAL_GPIO_WritePin(SVM_PUENTE1_PUERTO, (GPIO_U_IN|GPIO_U_SD|GPIO_V_IN|GPIO_V_SD|GPIO_W_IN|GPIO_W_SD) << SVM_PUENTE1_DESPLAZAMIENTO, GPIO_PIN_RESET);
+  GPIO_InitStruct.Pin = (GPIO_U_IN|GPIO_U_SD|GPIO_V_IN|GPIO_V_SD|GPIO_W_IN|GPIO_W_SD) << SVM_PUENTE1_DESPLAZAMIENTO;
+  HAL_GPIO_Init(SVM_PUENTE1_PUERTO, &GPIO_InitStruct);
+#endif
 }
 
 /**
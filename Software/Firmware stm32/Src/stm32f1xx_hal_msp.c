@@ -17,9 +17,12 @@
   */
 
 #include "main.h"
+#include "../Modules/Gestor_SVM/GestorSVM.h"
 
 extern DMA_HandleTypeDef hdma_spi2_tx;
 extern DMA_HandleTypeDef hdma_spi2_rx;
+extern DMA_HandleTypeDef hdma_tim3_up;
+extern DMA_HandleTypeDef hdma_tim3_ch3;
 
 /**
   * Initializes the Global MSP.
@@ -30,6 +33,59 @@ void HAL_MspInit(void) {
   __HAL_AFIO_REMAP_SWJ_NOJTAG();
 }
 
+#if SVM_CORRIENTE_SHUNT || SVM_VBUS_FUENTE == SVM_VBUS_ADC
+/**
+* @brief ADC MSP Initialization
+* ADC1: entrada analogica del shunt y fin de conversion con la prioridad de TIM3
+* ADC2: entrada analogica de la tension del bus, sin interrupciones
+* @param hadc: ADC handle pointer
+* @retval None
+*/
+void HAL_ADC_MspInit(ADC_HandleTypeDef* hadc) {
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+  if(hadc->Instance==ADC1) {
+    __HAL_RCC_ADC1_CLK_ENABLE();
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    /**ADC1 GPIO Configuration
+    PA0     ------> ADC1_IN0 (shunt)
+    */
+    GPIO_InitStruct.Pin = GPIO_SHUNT;
+    GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+    HAL_NVIC_SetPriority(ADC1_2_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(ADC1_2_IRQn);
+  } else if(hadc->Instance==ADC2) {
+    __HAL_RCC_ADC2_CLK_ENABLE();
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    /**ADC2 GPIO Configuration
+    PA7     ------> ADC2_IN7 (tension del bus)
+    */
+    GPIO_InitStruct.Pin = GPIO_VBUS;
+    GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+  }
+}
+
+/**
+* @brief ADC MSP De-Initialization
+* @param hadc: ADC handle pointer
+* @retval None
+*/
+void HAL_ADC_MspDeInit(ADC_HandleTypeDef* hadc) {
+  if(hadc->Instance==ADC1) {
+    __HAL_RCC_ADC1_CLK_DISABLE();
+    HAL_GPIO_DeInit(GPIOA, GPIO_SHUNT);
+    HAL_NVIC_DisableIRQ(ADC1_2_IRQn);
+  } else if(hadc->Instance==ADC2) {
+    __HAL_RCC_ADC2_CLK_DISABLE();
+    HAL_GPIO_DeInit(GPIOA, GPIO_VBUS);
+  }
+}
+#endif
+
 /**
 * @brief SPI MSP Initialization
 * This function configures the hardware resources used in this example
@@ -124,6 +180,14 @@ void HAL_SPI_MspDeInit(SPI_HandleTypeDef* hspi) {
 * @retval None
 */
 void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base) {
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+  if(htim_base->Instance==TIM1) {
+    __HAL_RCC_TIM1_CLK_ENABLE();
+    HAL_NVIC_SetPriority(TIM1_UP_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(TIM1_UP_IRQn);
+    return;
+  }
+#endif
   if(htim_base->Instance==TIM2) {
     __HAL_RCC_TIM2_CLK_ENABLE();
     HAL_NVIC_SetPriority(TIM2_IRQn, 0, 0);
@@ -132,9 +196,86 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base) {
     __HAL_RCC_TIM3_CLK_ENABLE();
     HAL_NVIC_SetPriority(TIM3_IRQn, 0, 0);
     HAL_NVIC_EnableIRQ(TIM3_IRQn);
+
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+    /* TIM3_UP -> DMA1 canal 3: palabras de 32 bits a GPIOA->BSRR */
+    hdma_tim3_up.Instance = DMA1_Channel3;
+    hdma_tim3_up.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_tim3_up.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_tim3_up.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_tim3_up.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    hdma_tim3_up.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    hdma_tim3_up.Init.Mode = DMA_CIRCULAR;
+    hdma_tim3_up.Init.Priority = DMA_PRIORITY_VERY_HIGH;
+    if (HAL_DMA_Init(&hdma_tim3_up) != HAL_OK) {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(htim_base,hdma[TIM_DMA_ID_UPDATE],hdma_tim3_up);
+
+    /* TIM3_CH3 -> DMA1 canal 2: medias palabras al ARR de TIM3 */
+    hdma_tim3_ch3.Instance = DMA1_Channel2;
+    hdma_tim3_ch3.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_tim3_ch3.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_tim3_ch3.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_tim3_ch3.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_tim3_ch3.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    hdma_tim3_ch3.Init.Mode = DMA_CIRCULAR;
+    hdma_tim3_ch3.Init.Priority = DMA_PRIORITY_HIGH;
+    if (HAL_DMA_Init(&hdma_tim3_ch3) != HAL_OK) {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(htim_base,hdma[TIM_DMA_ID_CC3],hdma_tim3_ch3);
+#endif
+#if SVM_CANTIDAD_PUENTES > 1
+  } else if(htim_base->Instance==TIM4) {
+    __HAL_RCC_TIM4_CLK_ENABLE();
+    HAL_NVIC_SetPriority(TIM4_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(TIM4_IRQn);
+#endif
   }
 }
 
+/**
+* @brief TIM MSP Post Initialization
+* Configura los pines de salida de TIM1 (solo con SVM_SALIDA_TIM1)
+* @param htim: TIM handle pointer
+* @retval None
+*/
+void HAL_TIM_MspPostInit(TIM_HandleTypeDef* htim) {
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+  if(htim->Instance==TIM1) {
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+
+    /**TIM1 GPIO Configuration (remapeo parcial)
+    PA8     ------> TIM1_CH1  (U)
+    PA9     ------> TIM1_CH2  (V)
+    PA10    ------> TIM1_CH3  (W)
+    PA7     ------> TIM1_CH1N
+    PB0     ------> TIM1_CH2N
+    PB1     ------> TIM1_CH3N
+    */
+    GPIO_InitStruct.Pin = GPIO_PIN_8|GPIO_PIN_9|GPIO_PIN_10;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+#if SVM_TIM1_COMPLEMENTARIAS
+    GPIO_InitStruct.Pin = GPIO_PIN_7;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+    GPIO_InitStruct.Pin = GPIO_PIN_0|GPIO_PIN_1;
+    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+#endif
+
+    __HAL_AFIO_REMAP_TIM1_PARTIAL();
+  }
+#endif
+}
+
 /**
 * @brief TIM_Base MSP De-Initialization
 * This function freeze the hardware resources used in this example
@@ -142,12 +283,28 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base) {
 * @retval None
 */
 void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef* htim_base) {
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+  if(htim_base->Instance==TIM1) {
+    __HAL_RCC_TIM1_CLK_DISABLE();
+    HAL_NVIC_DisableIRQ(TIM1_UP_IRQn);
+    return;
+  }
+#endif
   if(htim_base->Instance==TIM2) {
     __HAL_RCC_TIM2_CLK_DISABLE();
     HAL_NVIC_DisableIRQ(TIM2_IRQn);
   } else if(htim_base->Instance==TIM3) {
     __HAL_RCC_TIM3_CLK_DISABLE();
     HAL_NVIC_DisableIRQ(TIM3_IRQn);
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+    HAL_DMA_DeInit(htim_base->hdma[TIM_DMA_ID_UPDATE]);
+    HAL_DMA_DeInit(htim_base->hdma[TIM_DMA_ID_CC3]);
+#endif
+#if SVM_CANTIDAD_PUENTES > 1
+  } else if(htim_base->Instance==TIM4) {
+    __HAL_RCC_TIM4_CLK_DISABLE();
+    HAL_NVIC_DisableIRQ(TIM4_IRQn);
+#endif
   }
 }
 
@@ -161,6 +318,7 @@ void HAL_UART_MspInit(UART_HandleTypeDef* huart) {
   GPIO_InitTypeDef GPIO_InitStruct = {0};
   if(huart->Instance==USART1) {
     __HAL_RCC_USART1_CLK_ENABLE();
+#if SVM_USART1_REMAP
     __HAL_RCC_GPIOB_CLK_ENABLE();
 
     GPIO_InitStruct.Pin = GPIO_PIN_6;
@@ -174,6 +332,20 @@ void HAL_UART_MspInit(UART_HandleTypeDef* huart) {
     HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
 
     __HAL_AFIO_REMAP_USART1_ENABLE();
+#else
+    /* PB6/PB7 son del puente 1: TX en PA9 y RX en PA10, sin remap */
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+
+    GPIO_InitStruct.Pin = GPIO_PIN_9;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+    GPIO_InitStruct.Pin = GPIO_PIN_10;
+    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+#endif
   }
 
 }
@@ -188,7 +360,11 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* huart) {
   if(huart->Instance==USART1) {
     __HAL_RCC_USART1_CLK_DISABLE();
 
+#if SVM_USART1_REMAP
     HAL_GPIO_DeInit(GPIOB, GPIO_PIN_6|GPIO_PIN_7);
+#else
+    HAL_GPIO_DeInit(GPIOA, GPIO_PIN_9|GPIO_PIN_10);
+#endif
   }
 
 }
\ No newline at end of file
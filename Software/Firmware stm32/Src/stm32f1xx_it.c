@@ -22,8 +22,8 @@
 
 extern DMA_HandleTypeDef hdma_spi2_tx;
 extern DMA_HandleTypeDef hdma_spi2_rx;
+extern DMA_HandleTypeDef hdma_tim3_up;
 extern SPI_HandleTypeDef hspi2;
-extern TIM_HandleTypeDef htim2;
 extern TIM_HandleTypeDef htim3;
 
 /**
@@ -104,6 +104,15 @@ void SysTick_Handler(void) {
   HAL_IncTick();
 }
 
+#if SVM_SALIDA == SVM_SALIDA_GPIO_DMA
+/**
+  * @brief This function handles DMA1 channel3 global interrupt (TIM3_UP, BSRR del SVM).
+  */
+RAM_FUNC void DMA1_Channel3_IRQHandler(void) {
+  HAL_DMA_IRQHandler(&hdma_tim3_up);
+}
+#endif
+
 /**
   * @brief This function handles DMA1 channel4 global interrupt.
   */
@@ -118,20 +127,54 @@ void DMA1_Channel5_IRQHandler(void) {
   HAL_DMA_IRQHandler(&hdma_spi2_tx);
 }
 
+#if SVM_SALIDA == SVM_SALIDA_TIM1
+/**
+  * @brief This function handles TIM1 update interrupt (carga de CCR del SVM).
+  */
+RAM_FUNC void TIM1_UP_IRQHandler(void) {
+  GestorSVM_SwitchTimerInterrupt(0);
+}
+#endif
+
 /**
   * @brief This function handles TIM2 global interrupt.
   */
-void TIM2_IRQHandler(void) {
+RAM_FUNC void TIM2_IRQHandler(void) {
+  // Solo CC1 esta habilitado: se limpia directo, sin el despacho de la HAL
+  TIM2->SR = ~TIM_SR_CC1IF;
   GestorSVM_CalcInterrupt();
-  HAL_TIM_IRQHandler(&htim2);
 }
 
 /**
   * @brief This function handles TIM3 global interrupt.
   */
-void TIM3_IRQHandler(void) {
+RAM_FUNC void TIM3_IRQHandler(void) {
+#if SVM_SALIDA == SVM_SALIDA_GPIO_ISR
+  GestorSVM_SwitchTimerInterrupt(0);
+#else
   HAL_TIM_IRQHandler(&htim3);
+#endif
+}
+
+#if SVM_CANTIDAD_PUENTES > 1
+/**
+  * @brief This function handles TIM4 global interrupt (switching del puente 1).
+  */
+RAM_FUNC void TIM4_IRQHandler(void) {
+  GestorSVM_SwitchTimerInterrupt(1);
+}
+#endif
+
+#if SVM_CORRIENTE_SHUNT
+/**
+  * @brief This function handles ADC1 and ADC2 global interrupt (conversiones del shunt).
+  */
+RAM_FUNC void ADC1_2_IRQHandler(void) {
+  // Solo JEOC esta habilitado: se limpia directo, sin el despacho de la HAL
+  ADC1->SR = ~(ADC_SR_JEOC | ADC_SR_JSTRT);
+  GestorSVM_CorrienteInterrupt();
 }
+#endif
 
 /**
   * @brief This function handles SPI2 global interrupt.
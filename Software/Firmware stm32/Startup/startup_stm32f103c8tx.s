@@ -63,7 +63,9 @@ Reset_Handler:
 /* Call the clock system initialization function.*/
     bl  SystemInit
 
-/* Copy the data segment initializers from flash to SRAM */
+/* Copy the data segment initializers from flash to SRAM. The linker script places
+   .RamFunc* (SVM interrupt code and tables, see RAM_FUNC in main.h) inside .data,
+   so this loop also moves them to SRAM before main. */
   ldr r0, =_sdata
   ldr r1, =_edata
   ldr r2, =_sidata
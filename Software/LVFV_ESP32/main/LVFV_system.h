@@ -14,6 +14,10 @@
 
 #define LINE_INCREMENT                  9
 
+#define FREQ_RESOLUTION                 100                         /** @def FREQ_RESOLUTION @brief Unidades de frecuencia por Hz: todas las frecuencias del sistema están en centésimas de Hz */
+#define FREQ_MIN                        (5 * FREQ_RESOLUTION)       /** @def FREQ_MIN @brief Frecuencia de régimen mínima configurable [0.01 Hz] */
+#define FREQ_MAX                        (400 * FREQ_RESOLUTION)     /** @def FREQ_MAX @brief Frecuencia de régimen máxima configurable [0.01 Hz]. Igual a FERC_OUT_MAX del STM32 */
+
 #define VARIABLE_FIRST                  20
 #define VARIABLE_SECOND                 29
 #define VARIABLE_THIRD                  38
@@ -84,7 +88,7 @@ typedef enum sh1106_variable_lines_e{
 } sh1106_variable_lines_e;
 
 typedef struct frequency_settings_t {
-    uint16_t freq_regime;
+    uint16_t freq_regime;                                   // Frecuencia de régimen [0.01 Hz]
     uint16_t acceleration;
     uint16_t desacceleration;
     uint16_t input_variable;
@@ -107,8 +111,8 @@ typedef struct seccurity_settings_t {
  * @brief Estructura con las variables necesarias para establecer las condiciones de trabajo del motor
  */
 typedef struct system_status_t {
-    uint16_t frequency;                                     // Frecuencia actual de giro del motor
-    uint16_t frequency_destiny;                             // Frecuencia a la que terminará funcionando el motor
+    uint16_t frequency;                                     // Frecuencia actual de giro del motor [0.01 Hz]
+    uint16_t frequency_destiny;                             // Frecuencia a la que terminará funcionando el motor [0.01 Hz]
     uint16_t vbus_min;                                      // Tensión mínima del bus de contínua en la que será una condición buena
     uint16_t ibus_max;                                      // Corriente máxima del bus de contínua en la que será una condición buena
     uint16_t acceleration;                                  // Velocidad de aceleración del motor configurada por el usuario
@@ -129,7 +133,7 @@ typedef struct frequency_settings_SH1106_t {
     sh1106_variable_lines_e *edit;
     uint8_t edit_variable;
     uint8_t *edit_flag;
-    uint8_t *multiplier;
+    uint16_t *multiplier;
 } frequency_settings_SH1106_t;
 
 typedef struct time_settings_SH1106_t {
@@ -137,7 +141,7 @@ typedef struct time_settings_SH1106_t {
     sh1106_variable_lines_e *edit;
     uint8_t edit_variable;
     uint8_t *edit_flag;
-    uint8_t *multiplier;
+    uint16_t *multiplier;
 } time_settings_SH1106_t;
 
 typedef struct seccurity_settings_SH1106_t {
@@ -145,7 +149,7 @@ typedef struct seccurity_settings_SH1106_t {
     sh1106_variable_lines_e *edit;
     uint8_t edit_variable;
     uint8_t *edit_flag;
-    uint8_t *multiplier;
+    uint16_t *multiplier;
 } seccurity_settings_SH1106_t;
 
 #endif
\ No newline at end of file
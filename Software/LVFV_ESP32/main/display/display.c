@@ -353,12 +353,12 @@ static void sh1106_frequency_edit_variables(frequency_settings_SH1106_t *variabl
 
     if ( *(variables->edit) == EDIT_FREQUENCY_INDX && *(variables->edit_flag) ) {
         if ( blink >= 12 ) {
-            sprintf(num_str, "%03d", variables->frequency_settings.freq_regime);
-            sh1106_draw_text( &oled, num_str, 70, VARIABLE_FIRST, SH1106_SIZE_1);
+            sprintf(num_str, "%3d.%02d", variables->frequency_settings.freq_regime / FREQ_RESOLUTION, variables->frequency_settings.freq_regime % FREQ_RESOLUTION);
+            sh1106_draw_text( &oled, num_str, 55, VARIABLE_FIRST, SH1106_SIZE_1);
         }
     } else {
-        sprintf(num_str, "%03d", variables->frequency_settings.freq_regime);
-        sh1106_draw_text( &oled, num_str, 70, VARIABLE_FIRST, SH1106_SIZE_1);
+        sprintf(num_str, "%3d.%02d", variables->frequency_settings.freq_regime / FREQ_RESOLUTION, variables->frequency_settings.freq_regime % FREQ_RESOLUTION);
+        sh1106_draw_text( &oled, num_str, 55, VARIABLE_FIRST, SH1106_SIZE_1);
     } 
 
     if ( *(variables->edit) == EDIT_ACCELERATION_INDX && *(variables->edit_flag) ) {
@@ -437,8 +437,8 @@ static void sh1106_main_screen( ) {
     sh1106_draw_text( &oled, "Arranque:"  , 5, VARIABLE_FOURTH, SH1106_SIZE_1);
     sh1106_draw_text( &oled, "Parada:"    , 5, VARIABLE_FIFTH, SH1106_SIZE_1);
 
-    sprintf(hora_str, "%03d", s_e.frequency);
-    sh1106_draw_text( &oled, hora_str, 86, VARIABLE_FIRST, SH1106_SIZE_1);
+    sprintf(hora_str, "%3d.%02d", s_e.frequency / FREQ_RESOLUTION, s_e.frequency % FREQ_RESOLUTION);
+    sh1106_draw_text( &oled, hora_str, 80, VARIABLE_FIRST, SH1106_SIZE_1);
     sprintf(hora_str, "%03d", s_e.vbus_min);
     sh1106_draw_text( &oled, hora_str, 86, VARIABLE_SECOND, SH1106_SIZE_1);
     sprintf(hora_str, "%04d", s_e.ibus_max);
@@ -527,8 +527,8 @@ void task_display(void *pvParameters) {
     sh1106_variable_lines_e top_variable = first, bottom_variable = fifth;      // Identificador de la variable seleccionada
     sh1106_variable_lines_e variable_lines = VARIABLE_FIRST;
 
-    uint8_t top_multiplier = 100, bottom_multiplier = 1;                          // Incremental de la variable seleccionada
-    uint8_t multiplier = 1;
+    uint16_t top_multiplier = 100, bottom_multiplier = 1;                         // Incremental de la variable seleccionada
+    uint16_t multiplier = 1;
 
     uint32_t edit_variable_min = 0, edit_variable_max = 0;                       // Variable seleccionada
     uint16_t *edit_variable = NULL;
@@ -702,10 +702,14 @@ void task_display(void *pvParameters) {
                         multiplier = 1;
                     } else if ( screen_displayed == SCREEN_FREQUENCY_EDIT ) {
                         if ( edit_variable == NULL ) {
+                            multiplier = 1;
+                            top_multiplier = 100;
+                            bottom_multiplier = 1;
                             if ( variable_lines == EDIT_FREQUENCY_INDX ) {
                                 edit_variable = (uint16_t*) &(frequency_edit.frequency_settings.freq_regime);
-                                edit_variable_min = 5;
-                                edit_variable_max = 150;
+                                edit_variable_min = FREQ_MIN;
+                                edit_variable_max = FREQ_MAX;
+                                top_multiplier = 100 * FREQ_RESOLUTION;     // Pasos de 0.01 Hz a 100 Hz
                             } else if ( variable_lines == EDIT_ACCELERATION_INDX ) {
                                 edit_variable = (uint16_t*) &(frequency_edit.frequency_settings.acceleration);
                                 edit_variable_min = 1;
@@ -722,9 +726,6 @@ void task_display(void *pvParameters) {
                                 bottom_multiplier = 1;
                             }
                             edit = 1;
-                            multiplier = 1;
-                            top_multiplier = 100;
-                            bottom_multiplier = 1;
                         } else {
                             edit = 0;
                             edit_variable = NULL;
@@ -19,7 +19,7 @@
  * @brief Entrega el valor de frecuencia de regimen seteado por el usuario
  *
  * @retval
- *      Valor de frecuencia de regimen configurado por el usuario
+ *      Valor de frecuencia de regimen configurado por el usuario [0.01 Hz]
  */
 uint16_t get_system_frequency();
 /**
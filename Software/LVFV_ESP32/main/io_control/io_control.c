@@ -358,15 +358,15 @@ static void MCP23017_relay_control(void* arg) {
 
 esp_err_t set_freq_output(uint16_t freq)
 {
-    const uint16_t F_MAX    = 150;   // Hz
+    const uint32_t F_MAX    = 150 * FREQ_RESOLUTION;   // 0.01 Hz
     const uint16_t DUTY_MAX = 98;    // %
     const uint16_t DUTY_MIN = 54;    // %
     const uint32_t PWM_MAX  = 1023;  // ticks (10 bits)
 
     if (freq > F_MAX) freq = F_MAX;
 
-    // duty_pct = 98 - round( (44*freq)/150 )
-    uint16_t drop = (uint16_t)((44u * freq + 75u) / 150u);   // +75 para redondeo
+    // duty_pct = 98 - round( (44*freq)/F_MAX )
+    uint16_t drop = (uint16_t)((44u * freq + F_MAX / 2) / F_MAX);   // + F_MAX/2 para redondeo
     int duty_pct  = (int)DUTY_MAX - (int)drop;
 
     if (duty_pct < DUTY_MIN) duty_pct = DUTY_MIN;
@@ -378,7 +378,7 @@ esp_err_t set_freq_output(uint16_t freq)
     if (ledc_get_duty(PWM_MODE, PWM_CHANNEL) != ticks) {
         ESP_ERROR_CHECK(ledc_set_duty(PWM_MODE, PWM_CHANNEL, ticks));
         ESP_ERROR_CHECK(ledc_update_duty(PWM_MODE, PWM_CHANNEL));
-        ESP_LOGI("PWM", "Freq=%u Hz, Duty=%d%% (ticks=%lu)", freq, duty_pct, (unsigned long)ticks);
+        ESP_LOGI("PWM", "Freq=%u.%02u Hz, Duty=%d%% (ticks=%lu)", freq / FREQ_RESOLUTION, freq % FREQ_RESOLUTION, duty_pct, (unsigned long)ticks);
     }
     return ESP_OK;
 }
@@ -13,7 +13,8 @@
 #include "../LVFV_system.h"
 #include "./nvs.h"
 
-#define save_frequency(freq_op)                                 save_16("freq_freq", (freq_op) )
+// La frecuencia se guarda en centésimas de Hz, con otra clave que la de Hz enteros para no leer un valor viejo en otra escala
+#define save_frequency(freq_op)                                 save_16("freq_cHz", (freq_op) )
 #define save_acceleration(freq_acceleration)                    save_16("freq_acce", (freq_acceleration) )
 #define save_desacceleration(freq_desacceleration)              save_16("freq_desa", (freq_desacceleration) )
 #define save_input_variable(freq_input_variable)                save_16("freq_input", (freq_input_variable) )
@@ -24,7 +25,7 @@
 #define save_hour_fin(hour_fin)                                 save_16("hour_fin", (hour_fin) )
 #define save_min_fin(min_fin)                                   save_16("min_fin", (min_fin) )
 
-#define load_frequency(freq_op)                                 load_16("freq_freq", (freq_op), 50 )
+#define load_frequency(freq_op)                                 load_16("freq_cHz", (freq_op), 50 * FREQ_RESOLUTION )
 #define load_acceleration(freq_acceleration)                    load_16("freq_acce", (freq_acceleration), 5 )
 #define load_desacceleration(freq_desacceleration)              load_16("freq_desa", (freq_desacceleration), 3 )
 #define load_input_variable(freq_input_variable)                load_16("freq_input", (freq_input_variable), 1 )
@@ -22,7 +22,7 @@
 static const char *TAG = "sysAdmin";                            /** @var TAG @brief Etiqueta para imprimir con ESP_LOG */
 static system_status_t system_status;                           /** @var system_status @brief Status general del sistema. */
 static seccurity_settings_t system_seccurity_settings;          /** @var system_seccurity_settings @brief Estructura con las variables de seguridad del sistema */
-static uint16_t frequency_table[8];                             /** @var frequency_table @brief Tabla de valores de frecuencias para cambios de frecuencia con las entradas aisladas */
+static uint16_t frequency_table[8];                             /** @var frequency_table @brief Tabla de valores de frecuencias [0.01 Hz] para cambios de frecuencia con las entradas aisladas */
 static TaskHandle_t accelerating_handle = NULL;                 /** @var accelerating_handle @brief Handeler de la tarea de aceleración. Permite que una tarea termine a la otra o que sea cerrada desde otra función */
 static TaskHandle_t desaccelerating_handle = NULL;              /** @var desaccelerating_handle @brief Handeler de la tarea de desaceleración. Permite que una tarea termine a la otra o que sea cerrada desde otra función */
 
@@ -54,10 +54,10 @@ static void accelerating(void *pvParameters ) {
     // uint16_t acceleration = *((uint16_t*)pvParameters);
     vTaskDelay(pdMS_TO_TICKS(200));
     while( system_status.frequency != system_status.frequency_destiny ) {
-        if ( (system_status.frequency + system_status.acceleration ) > system_status.frequency_destiny ) {
+        if ( (system_status.frequency + system_status.acceleration * FREQ_RESOLUTION ) > system_status.frequency_destiny ) {
             system_status.frequency = system_status.frequency_destiny;
         } else {
-            system_status.frequency += system_status.acceleration;
+            system_status.frequency += system_status.acceleration * FREQ_RESOLUTION;
         }
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
@@ -70,10 +70,10 @@ static void desaccelerating( void *pvParameters ) {
     // uint16_t desacceleration = *((uint16_t*)pvParameters);
     vTaskDelay(pdMS_TO_TICKS(200));
     while( system_status.frequency != system_status.frequency_destiny ) {
-        if ( system_status.frequency - system_status.desacceleration < system_status.frequency_destiny ) {
+        if ( system_status.frequency - system_status.desacceleration * FREQ_RESOLUTION < system_status.frequency_destiny ) {
             system_status.frequency = system_status.frequency_destiny;
-        } else if ( system_status.frequency > system_status.desacceleration ) {
-            system_status.frequency -= system_status.desacceleration;
+        } else if ( system_status.frequency > system_status.desacceleration * FREQ_RESOLUTION ) {
+            system_status.frequency -= system_status.desacceleration * FREQ_RESOLUTION;
         } else {
             system_status.frequency = 0;
         }
@@ -240,8 +240,8 @@ void set_frequency_table( uint16_t input_variable, uint16_t freq_regime ) {
         for (uint8_t i = 0; i < 8; i++) {
             uint32_t num = (uint32_t)freq_regime * (uint32_t)(i + 1) * (uint32_t)(i + 1);
             uint16_t fi  = (uint16_t)((num + 32) / 64);
-            if (fi == 0)
-                fi = 1;
+            if (fi < FREQ_RESOLUTION)
+                fi = FREQ_RESOLUTION;
             frequency_table[7 - i] = fi;
             ESP_LOGI(TAG, "frequency_table[%d] = %d", 7 - i, frequency_table[7 - i]);
         }
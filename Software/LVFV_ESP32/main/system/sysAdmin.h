@@ -33,7 +33,7 @@ esp_err_t get_status(system_status_t *s_e);
  *
  * @details En caso de que desaccelerating esté corriendo, antes de ejecutar accelerating, la cierra para no generar un efecto de subida y bajada de frecuencia. El status pasará a SYSTEM_ACCLE_DESACCEL
  * 
- * @return Frecuencia de destino configurada
+ * @return Frecuencia de destino configurada [0.01 Hz]
  */
 uint16_t engine_start();
 
@@ -80,7 +80,7 @@ void engine_emergency_stop(uint8_t signal);
  * @param[in] speed_slector
  *      Índice dentro del array con frecuencias de trabajo
  *
- * @return 0Hz si @p speed_selector fue mal pasada como argumento, sino la frecuencia de destino
+ * @return 0Hz si @p speed_selector fue mal pasada como argumento, sino la frecuencia de destino [0.01 Hz]
  */
 uint16_t change_frequency(uint8_t speed_slector);
 
@@ -117,7 +117,7 @@ system_status_e update_meas(uint16_t vbus_meas, uint16_t ibus_meas);
  *      Tipo de variación entre las diferentes entradas. 1 para variación lineal; 2 para variación cuadrática.
  *
  * @param[in] freq_regime
- *      Frecuencia de regimen ingresada por el usuario
+ *      Frecuencia de regimen ingresada por el usuario [0.01 Hz]
  */
 void set_frequency_table( uint16_t input_variable, uint16_t freq_regime );
 
@@ -7,6 +7,7 @@
  * 
  */
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "esp_log.h"
@@ -37,6 +38,9 @@
 #define SPI_CLOCK_HZ                    1*1000*1000             /** @def SPI_CLOCK_HZ @brief Velocidad de clock: 1 MHz */
 #define SPI_QUEUE_TX_DEPTH              1                       /** @def SPI_QUEUE_TX_DEPTH @brief Profundidad de comandos para el puerto SPI */
 
+// ===== Tensión del bus =====
+#define VBUS_DELTA_ENVIO                2                       /** @def VBUS_DELTA_ENVIO @brief Cambio de la tensión del bus [V] a partir del cual se vuelve a enviar al STM32 para la compensación de la modulación */
+
 static const char *TAG = "sysControl";                          /** @var TAG @brief Etiqueta para imprimir con ESP_LOG */
 
 QueueHandle_t system_event_queue = NULL;                        /** @var system_event_queue @brief Cola de eventos para enviar comandos al STM32 */
@@ -70,21 +74,34 @@ static SPI_Response SPI_SendRequest(spi_cmd_item_t *spi_cmd_item) {
     uint8_t rx_buffer[4];
     esp_err_t ret;
     int flagDevolverValor;      // Se necesita devolver el valor por parametro
+    int flagValor16Bits;        // El valor viaja en 16 bits, byte alto primero
 
     ESP_LOGI( TAG, "[SPI Module] Request %d", spi_cmd_item->request);
 
-    // Chequeo de errores fuera de rango y comando desconocido
-    if(spi_cmd_item->setValue > 512 || spi_cmd_item->setValue < 0) {
-        return SPI_RESPONSE_ERR_DATA_INVALID;
-    }
-
-    if(spi_cmd_item->request < SPI_REQUEST_START || spi_cmd_item->request > SPI_REQUEST_EMERGENCY) {
+    if(spi_cmd_item->request < SPI_REQUEST_START || spi_cmd_item->request > SPI_REQUEST_GET_PERFIL) {
         ESP_LOGI( TAG, "[SPI Module] Comando desconocido\n");
         return SPI_RESPONSE_ERR_CMD_UNKNOWN;
     }
 
+    // Las frecuencias, la tensión del bus y el perfil viajan en 16 bits, el resto de los datos en un byte
+    if(spi_cmd_item->request == SPI_REQUEST_SET_FREC || spi_cmd_item->request == SPI_REQUEST_GET_FREC ||
+       spi_cmd_item->request == SPI_REQUEST_SET_FREC_SWITCH || spi_cmd_item->request == SPI_REQUEST_GET_FREC_SWITCH ||
+       spi_cmd_item->request == SPI_REQUEST_SET_VBUS || spi_cmd_item->request == SPI_REQUEST_GET_VBUS ||
+       spi_cmd_item->request == SPI_REQUEST_GET_PERFIL) {
+        flagValor16Bits = 1;
+    }else {
+        flagValor16Bits = 0;
+    }
+
+    // Chequeo de errores fuera de rango
+    if(spi_cmd_item->setValue < 0 || spi_cmd_item->setValue > (flagValor16Bits ? 0xFFFF : 0xFF)) {
+        return SPI_RESPONSE_ERR_DATA_INVALID;
+    }
+
     // Es de los comandos que deben devolver un valor por parametro?
-    if(spi_cmd_item->request >= SPI_REQUEST_GET_FREC && spi_cmd_item->request <= SPI_REQUEST_IS_STOP) {
+    if((spi_cmd_item->request >= SPI_REQUEST_GET_FREC && spi_cmd_item->request <= SPI_REQUEST_IS_STOP) ||
+       spi_cmd_item->request == SPI_REQUEST_GET_FREC_SWITCH || spi_cmd_item->request == SPI_REQUEST_GET_MODULADOR ||
+       spi_cmd_item->request == SPI_REQUEST_GET_VBUS || spi_cmd_item->request == SPI_REQUEST_GET_PERFIL) {
         flagDevolverValor = 1;
     }else {
         flagDevolverValor = 0;
@@ -93,9 +110,9 @@ static SPI_Response SPI_SendRequest(spi_cmd_item_t *spi_cmd_item) {
     // Se arma la cadena a enviar
     tx_buffer[0] = spi_cmd_item->request;
 
-    if(spi_cmd_item->setValue > 255) {
-        tx_buffer[1] = 255;
-        tx_buffer[2] = spi_cmd_item->setValue - 255;
+    if(flagValor16Bits) {
+        tx_buffer[1] = (uint8_t)(spi_cmd_item->setValue >> 8);
+        tx_buffer[2] = (uint8_t)spi_cmd_item->setValue;
         tx_buffer[3] = ';';
     }else {
         tx_buffer[1] = spi_cmd_item->setValue;
@@ -142,7 +159,11 @@ static SPI_Response SPI_SendRequest(spi_cmd_item_t *spi_cmd_item) {
     ESP_LOGI( TAG, "rx_buffer[0]: %d", rx_buffer[0]);
     if(flagDevolverValor && rx_buffer[0] == SPI_RESPONSE_OK) {
         
-        spi_cmd_item->getValue = rx_buffer[1] + rx_buffer[2];
+        if(flagValor16Bits) {
+            spi_cmd_item->getValue = (rx_buffer[1] << 8) | rx_buffer[2];
+        }else {
+            spi_cmd_item->getValue = rx_buffer[1];
+        }
         ESP_LOGI( TAG, "RxValores: %d - %d", rx_buffer[1], rx_buffer[2]);
         
     }else {
@@ -185,6 +206,7 @@ esp_err_t SPI_Init(void) {
 
 void SPI_communication(void *arg) {
     spi_cmd_item_t item;
+    uint16_t vbus_enviada = 0;
 
     systemSignal_e new_button;
 
@@ -225,8 +247,21 @@ void SPI_communication(void *arg) {
 
     while (1) {
         system_status_t s_e;
+        bool nueva_medicion = readADC();
         get_status( &s_e );
-        readADC();
+
+        // El STM32 compensa el índice de modulación con la tensión del bus: se envía cuando cambia
+        if ( nueva_medicion && abs( (int) s_e.vbus_min - (int) vbus_enviada ) >= VBUS_DELTA_ENVIO ) {
+            item.request = SPI_REQUEST_SET_VBUS;
+            item.setValue = s_e.vbus_min;
+            item.getValue = 0;
+            if ( SPI_SendRequest(&item) != SPI_RESPONSE_OK ) {
+                ESP_LOGI(TAG, "El STM32 no tomó la tensión del bus (sin compensación por SPI)");
+            }
+            // Aunque la rechace, no se reintenta hasta el próximo cambio
+            vbus_enviada = s_e.vbus_min;
+        }
+
         if ( xQueueReceive( system_event_queue, &new_button, pdMS_TO_TICKS(20) ) ) {
             switch ( new_button ) {
                 case EMERGENCI_STOP_PRESSED:
@@ -341,7 +376,7 @@ void SPI_communication(void *arg) {
                             break;
                         }
                         uint16_t dest = engine_start();
-                        ESP_LOGI(TAG, "Motor arrancado. Frecuencia destino: %d", dest);
+                        ESP_LOGI(TAG, "Motor arrancado. Frecuencia destino: %d.%02d Hz", dest / FREQ_RESOLUTION, dest % FREQ_RESOLUTION);
                     } else {
                         ESP_LOGE(TAG,"El motor debe estar detenido para poder arrancarlo");
                     }
@@ -19,16 +19,24 @@
 typedef enum {
     SPI_REQUEST_START = 10,                     // 10 - Comando de arranque de motor
     SPI_REQUEST_STOP,                           // 11 - Comando de parada de motor
-    SPI_REQUEST_SET_FREC,                       // 12 - Comando para configurar la frecuencia de régimen
+    SPI_REQUEST_SET_FREC,                       // 12 - Comando para configurar la frecuencia de régimen [0.01 Hz]
     SPI_REQUEST_SET_ACEL,                       // 13 - Comando para setear la aceleración hasta la frecuencia de régimen
     SPI_REQUEST_SET_DESACEL,                    // 14 - Comando para setear la desaceleración a 0Hz o frecuencia de régimen
     SPI_REQUEST_SET_DIR,                        // 15 - Comando para setear la dirección - TODO
-    SPI_REQUEST_GET_FREC,                       // 16 - Comando de consulta de frecuencia de régimen
+    SPI_REQUEST_GET_FREC,                       // 16 - Comando de consulta de frecuencia de régimen [0.01 Hz]
     SPI_REQUEST_GET_ACEL,                       // 17 - Comando de consulta de aceleración
     SPI_REQUEST_GET_DESACEL,                    // 18 - Comando de consulta de desaceleración
     SPI_REQUEST_GET_DIR,                        // 19 - Comando de consulta de dirección de giro
     SPI_REQUEST_IS_STOP,                        // 20 - Comando de consulta para saber si el motor está parado o en movimiento
     SPI_REQUEST_EMERGENCY,                      // 21 - Comando para entrar en estado de emergencia - deja de conmutar la salida
+    SPI_REQUEST_SET_FREC_SWITCH,                // 22 - Comando para configurar la frecuencia de switching [Hz] - solo con el motor detenido
+    SPI_REQUEST_GET_FREC_SWITCH,                // 23 - Comando de consulta de frecuencia de switching efectiva [Hz]
+    SPI_REQUEST_SET_MODULADOR,                  // 24 - Comando para seleccionar el modulador: 0 SVPWM, 1 SPWM, 2 THIPWM
+    SPI_REQUEST_GET_MODULADOR,                  // 25 - Comando de consulta del modulador
+    SPI_REQUEST_SET_VBUS,                       // 26 - Comando para informar la tensión del bus medida [V], con la que el STM32 compensa la modulación
+    SPI_REQUEST_GET_VBUS,                       // 27 - Comando de consulta de la tensión del bus filtrada en el STM32 [V]
+    SPI_REQUEST_RESET_PERFIL,                   // 28 - Comando para reiniciar la medición de ciclos de las interrupciones del SVM (STM32 compilado con SVM_PERFIL)
+    SPI_REQUEST_GET_PERFIL,                     // 29 - Comando de consulta de la medición de un camino de interrupción: setValue = camino << 8 | campo [ciclos]
     SPI_REQUEST_RESPONSE = 0x50                 // 80 - Comando para pedirle al STM32 la respuesta al comando enviado
 } SPI_Request;
 
@@ -46,6 +54,7 @@ typedef enum {
     SPI_RESPONSE_ERR_DATA_MISSING,              // 165 - Faltó enviar un dato dentro de la trama
     SPI_RESPONSE_ERR_DATA_INVALID,              // 166 - Los datos enviados como argumento dentro del comando están fuera de rango
     SPI_RESPONSE_ERR_DATA_OUT_RANGE,            // 167 - Comando con datos fuera de rango permitido
+    SPI_RESPONSE_ERR_EMERGENCY_ACTIVE,          // 168 - Comando no permitido con la emergencia activa
     SPI_RESPONSE_OK = 0xFF,                     // 255 - La comunicación entre ESP32 y STM32 fue exitosa
 } SPI_Response;
 
@@ -62,6 +71,12 @@ typedef struct {
     int setValue;                               // Dato enviado con los comandos set
 } spi_cmd_item_t;
 
+/*
+ * Trama de 4 bytes: CMD, DATO_ALTO, DATO_BAJO, ';'. Las frecuencias (SET/GET_FREC en centésimas de Hz,
+ * SET/GET_FREC_SWITCH en Hz) y la tensión del bus (SET/GET_VBUS en V) viajan en 16 bits, byte alto primero; el resto
+ * de los datos en un byte. GET_PERFIL envía el camino en el byte alto y el campo en el bajo, y recibe el valor en 16 bits.
+ */
+
 /**
  * @fn esp_err_t SPI_Init(void);
  *
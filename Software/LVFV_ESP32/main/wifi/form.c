@@ -39,7 +39,7 @@ const char *HTML_FORM =
 
 "    <div class=\"col-md-4\">"
 "      <label class=\"form-label\">Frecuencia de operación (Hz)</label>"
-"      <input type=\"number\" class=\"form-control\" name=\"frequency\" min=\"1\" max=\"150\" required>"
+"      <input type=\"number\" class=\"form-control\" name=\"frequency\" min=\"5\" max=\"400\" step=\"0.01\" required>"
 "    </div>"
 
 "    <div class=\"col-md-4\">"
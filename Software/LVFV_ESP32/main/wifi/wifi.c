@@ -190,8 +190,9 @@ static esp_err_t save_post_handler(httpd_req_t *req) {
     char stop_time_str[16] = {0};
 
     if (get_param_value(body, "frequency", buf, sizeof(buf))) {
-        frequency = atoi(buf);
-        ESP_LOGI(TAG, "Frecuencia: %d", frequency);
+        /* Hz con hasta dos decimales, a centésimas de Hz */
+        frequency = (int)(atof(buf) * FREQ_RESOLUTION + 0.5);
+        ESP_LOGI(TAG, "Frecuencia: %d.%02d Hz", frequency / FREQ_RESOLUTION, frequency % FREQ_RESOLUTION);
     }
     if (get_param_value(body, "accel", buf, sizeof(buf))) {
         accel = atoi(buf);
@@ -0,0 +1,152 @@
+/**
+ * @file SVM_BancoCalculo.c
+ * @brief Banco de prueba en PC del núcleo de cálculo SVM del firmware (CalculoSVM.c).
+ * @details
+ *   Compila el mismo CalculoSVM.c del firmware, sin el HAL y con @ref RAM_FUNC / @ref RAM_CONST vacíos, y:
+ *   - Barre índice de modulación × ángulo de sector y compara t0/t1/t2 con las ecuaciones de get_time_vector
+ *     (SVM_Calculos.py), igual que comparar() de SVM_CalculoPuntoFijo.py pero sobre el código C.
+ *   - Mide el costo por muestra (@ref CalculoSVM_AnguloSector + @ref CalculoSVM_Tiempos) en ciclos y ns del host.
+ *     No son ciclos del Cortex-M3: sirven para comparar versiones del núcleo entre sí.
+ *
+ *   Uso (desde esta carpeta):
+ *     gcc -O2 -Wall -I"../Firmware stm32/Src" -o SVM_BancoCalculo SVM_BancoCalculo.c -lm && ./SVM_BancoCalculo [ticksMedioPeriodo]
+ *   El -I solo resuelve el include "../Inc/main.h" de CalculoSVM.c; su contenido se saltea con la guarda.
+ *
+ *   Sin argumento usa 14336 ticks, el ticksMedioPeriodo del firmware a @ref FREC_SWITCH (2511 Hz, PSC 0).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/* main.h del firmware trae el HAL: se reemplaza por lo único que usa CalculoSVM.c */
+#define __MAIN_H
+#define RAM_FUNC
+#define RAM_CONST
+#include "../Firmware stm32/Modules/Gestor_SVM/CalculoSVM.c"
+
+/** @brief ticksMedioPeriodo del firmware a 2511 Hz: 36 MHz / 2511 − 1. */
+#define TICKS_MEDIO_PERIODO_FIRMWARE    14336
+
+/** @brief Paso del barrido de ángulo de sector (65536 = 60°), el mismo de comparar() en Python. */
+#define PASO_ANGULO                     64
+
+/** @brief Muestras de la medición de tiempo. */
+#define MUESTRAS_TIEMPO                 10000000
+
+/**
+ * @brief Tiempos exactos de get_time_vector para el medio período del firmware.
+ * @details get_time_vector usa el período completo (Ts = 2·ticks) y su t0 es el nulo total (V0 + V7); el firmware
+ *          usa la mitad.
+ */
+static void Banco_Referencia(double anguloGrados, int indice, int ticks, double* t) {
+    double ts = 2.0 * ticks;
+    double m = indice / 100.0;
+    double t2 = (3.0 / M_PI / 2.0) * ts * m * sin(anguloGrados * M_PI / 180.0);
+    double t1 = (3.0 * sqrt(3.0) / (2.0 * M_PI) / 2.0) * ts * m * cos(anguloGrados * M_PI / 180.0) - t2 / 2.0;
+
+    t[0] = (ts / 2.0 - t1 - t2) / 2.0;
+    t[1] = t1;
+    t[2] = t2;
+}
+
+/** @brief Error máximo y RMS de t0/t1/t2 contra la referencia, con redondeo (resto NULL) o con el sigma-delta. */
+static void Banco_Comparar(int ticks, int sigmaDelta) {
+    ModulacionSVM modulacion;
+    RestoTiemposSVM resto;
+    TiemposSVM tiempos;
+    double referencia[3];
+    double error;
+    double maximo[3] = {0, 0, 0};
+    double cuadrados[3] = {0, 0, 0};
+    long cantidad = 0;
+    uint32_t angulo;
+    int indice;
+    int k;
+
+    for (indice = 1; indice <= 100; indice++) {
+        CalculoSVM_Modulacion(indice, ticks, &modulacion);
+        resto = (RestoTiemposSVM){{{0}}};
+        for (angulo = 0; angulo < CALCULO_SVM_ANGULO_SECTOR; angulo += PASO_ANGULO) {
+            CalculoSVM_Tiempos(angulo, &modulacion, ticks, sigmaDelta ? &resto : NULL, &tiempos);
+            Banco_Referencia(60.0 * angulo / CALCULO_SVM_ANGULO_SECTOR, indice, ticks, referencia);
+
+            for (k = 0; k < 3; k++) {
+                error = fabs((k == 0 ? tiempos.t0 : (k == 1 ? tiempos.t1 : tiempos.t2)) - referencia[k]);
+                if (error > maximo[k]) {
+                    maximo[k] = error;
+                }
+                cuadrados[k] += error * error;
+            }
+            cantidad++;
+        }
+    }
+
+    printf("  %-26s max %7.3f %7.3f %7.3f   RMS %6.3f %6.3f %6.3f\n", sigmaDelta ? "Sigma-delta" : "Redondeo",
+           maximo[0], maximo[1], maximo[2],
+           sqrt(cuadrados[0] / cantidad), sqrt(cuadrados[1] / cantidad), sqrt(cuadrados[2] / cantidad));
+}
+
+/** @brief Costo por muestra del productor: ángulo de sector y tiempos con el sigma-delta, a índice 80. */
+static void Banco_Tiempo(int ticks) {
+    ModulacionSVM modulacion;
+    RestoTiemposSVM resto = {{{0}}};
+    TiemposSVM tiempos;
+    struct timespec inicio, fin;
+    volatile int sumidero = 0;
+    uint32_t fase = 0;
+    uint32_t anguloSector;
+    int sector;
+    long i;
+    double ns;
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t ciclos;
+#endif
+
+    CalculoSVM_Modulacion(80, ticks, &modulacion);
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+#if defined(__x86_64__) || defined(__i386__)
+    ciclos = __rdtsc();
+#endif
+    for (i = 0; i < MUESTRAS_TIEMPO; i++) {
+        /* Avance de fase de 50 Hz a 2511 Hz de muestreo */
+        fase += 85525u * 1000u;
+        anguloSector = CalculoSVM_AnguloSector(fase, &sector);
+        CalculoSVM_Tiempos(anguloSector, &modulacion, ticks, &resto, &tiempos);
+        sumidero += tiempos.t0 + tiempos.t1 + tiempos.t2 + sector;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    ciclos = __rdtsc() - ciclos;
+#endif
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+
+    ns = (fin.tv_sec - inicio.tv_sec) * 1e9 + (fin.tv_nsec - inicio.tv_nsec);
+    printf("Costo por muestra (host): %.1f ns", ns / MUESTRAS_TIEMPO);
+#if defined(__x86_64__) || defined(__i386__)
+    printf(", %.1f ciclos de TSC", (double)ciclos / MUESTRAS_TIEMPO);
+#endif
+    printf("\n");
+    (void)sumidero;
+}
+
+int main(int argc, char** argv) {
+    int ticks = (argc > 1) ? atoi(argv[1]) : TICKS_MEDIO_PERIODO_FIRMWARE;
+
+    if (ticks < 1 || ticks > 65535) {
+        fprintf(stderr, "ticksMedioPeriodo fuera de rango: %d\n", ticks);
+        return 1;
+    }
+
+    printf("Error contra get_time_vector [ticks], %d ticks de medio periodo, indices 1..100\n", ticks);
+    printf("  %-26s     %7s %7s %7s       %6s %6s %6s\n", "", "t0", "t1", "t2", "t0", "t1", "t2");
+    Banco_Comparar(ticks, 0);
+    Banco_Comparar(ticks, 1);
+    Banco_Tiempo(ticks);
+    return 0;
+}
@@ -0,0 +1,186 @@
+import numpy as np
+
+from SVM_Calculos import get_time_vector
+
+# Modelo en Python del calculo en punto fijo del firmware (CalculoSVM.c).
+# Sirve para dos cosas:
+#   - Generar la tabla de seno de cuarto de onda que se copia en CalculoSVM.c
+#   - Comparar, bit a bit, el resultado entero contra get_time_vector (referencia)
+#     y contra la regresion lineal que usaba antes el firmware.
+
+# Pasos de la tabla de 0 a 90 grados. Con 96 pasos, 60 grados son 64 pasos
+# y el angulo de sector (Q16, 65536 = 60 grados) indexa la tabla con >> 10
+TABLA_N = 96
+TABLA_SHIFT = 10
+ANGULO_SECTOR = 65536
+SENO_ESCALA = 32767
+
+# Ticks de medio periodo del timer de switching (t0 + t1 + t2 + t0): ticksMedioPeriodo del
+# firmware a 2511 Hz con PSC 0 (36 MHz / 2511 - 1)
+TICKS_MEDIO_PERIODO = 14336
+
+# Escala de la regresion lineal previa: se ajusto con el timer a 256 ticks de medio periodo
+TICKS_PERIODO_REGRESION = 255
+
+# Constante 3 / pi / 100 en Q32 (indice de modulacion 0..100)
+CONST_3_PI_Q32 = 41013917
+
+# Sigma-delta de t1/t2 (CALCULO_SVM_RESTO_BITS / CALCULO_SVM_ORDEN_RUIDO)
+RESTO_BITS = 12
+ORDEN_RUIDO = 1
+
+# Constantes de la regresion lineal previa del firmware
+CONST_CALC_T1_PROP = -3.59145E-6
+CONST_CALC_T1_ORD_ORG = 224.2845426
+CONST_CALC_T2_PROP = +3.59145E-6
+CONST_CALC_T2_ORD_ORG = 8.797345358
+
+
+def generar_tabla():
+    tabla = [int(round(SENO_ESCALA * np.sin(np.radians(90 * i / TABLA_N)))) for i in range(TABLA_N + 1)]
+    # Entrada de guarda para poder interpolar en 90 grados exactos
+    tabla.append(SENO_ESCALA)
+    return tabla
+
+
+TABLA = generar_tabla()
+
+
+def imprimir_tabla_c():
+    print("static const int16_t tablaSenoCuartoOnda[CALCULO_SVM_TABLA_N + 2] = {")
+    for k in range(0, len(TABLA), 10):
+        print("    " + ", ".join("%5d" % v for v in TABLA[k:k + 10]) + ",")
+    print("};")
+
+
+# Igual a CalculoSVM_Seno: angulo en unidades de sector (65536 = 60 grados)
+def seno_fijo(angulo):
+    i = angulo >> TABLA_SHIFT
+    f = angulo & ((1 << TABLA_SHIFT) - 1)
+    a = TABLA[i]
+    return a + (((TABLA[i + 1] - a) * f) >> TABLA_SHIFT)
+
+
+# Igual a CalculoSVM_Ganancia: (3/pi) * ticks * M en Q16
+def ganancia_fija(indice_modulacion, ticks_periodo):
+    return (ticks_periodo * indice_modulacion * CONST_3_PI_Q32) >> 16
+
+
+# Igual a CalculoSVM_Cuantizar: producto Q31 a ticks. error es la lista [e(n-1), e(n-2)]
+# del canal (se modifica), o None para redondear
+def cuantizar(producto, error, orden=ORDEN_RUIDO):
+    if error is None or orden == 0:
+        return (producto + (1 << 30)) >> 31
+    valor = producto >> (31 - RESTO_BITS)
+    if orden == 1:
+        valor += error[0]
+    else:
+        valor += 2 * error[0] - error[1]
+        error[1] = error[0]
+    ticks = (valor + (1 << (RESTO_BITS - 1))) >> RESTO_BITS
+    if ticks < 0:
+        error[0] = 0
+        return 0
+    error[0] = valor - (ticks << RESTO_BITS)
+    return ticks
+
+
+# Igual a CalculoSVM_Tiempos. retencion / escala: modo II de sobremodulacion
+# (angulo de retencion en unidades de sector y escala Q16 del resto del sector).
+# resto: [[t1], [t2]] con los errores del sigma-delta (RestoTiemposSVM), o None
+def tiempos_fijo(angulo_sector, ganancia, ticks_periodo, retencion=0, escala=0, resto=None, orden=ORDEN_RUIDO):
+    if retencion:
+        if angulo_sector <= retencion:
+            angulo_sector = 0
+        elif angulo_sector >= ANGULO_SECTOR - retencion:
+            angulo_sector = ANGULO_SECTOR
+        else:
+            angulo_sector = ((angulo_sector - retencion) * escala) >> 16
+    t1 = cuantizar(ganancia * seno_fijo(ANGULO_SECTOR - angulo_sector), resto[0] if resto else None, orden)
+    t2 = cuantizar(ganancia * seno_fijo(angulo_sector), resto[1] if resto else None, orden)
+    # Fuera del hexagono: proyeccion radial sobre su lado
+    if t1 + t2 > ticks_periodo:
+        t1 = (t1 * ticks_periodo) // (t1 + t2)
+        t2 = ticks_periodo - t1
+    t0 = max((ticks_periodo - t1 - t2) >> 1, 0)
+    return t0, t1, t2
+
+
+def tiempos_regresion(angulo_grados, indice_modulacion):
+    angulo = angulo_grados * 1e6
+    t1 = int(((CONST_CALC_T1_PROP * angulo + CONST_CALC_T1_ORD_ORG) * indice_modulacion) / 100)
+    t2 = int(((CONST_CALC_T2_PROP * angulo + CONST_CALC_T2_ORD_ORG) * indice_modulacion) / 100)
+    t0 = int((TICKS_PERIODO_REGRESION - t1 - t2) * 0.5)
+    return t0, t1, t2
+
+
+# Referencia: el periodo de get_time_vector es el periodo completo (subida y
+# bajada), por lo que Ts = 2 * ticks. Su t0 es el tiempo nulo total del medio
+# periodo (V0 + V7), el firmware usa la mitad.
+def tiempos_referencia(angulo_grados, indice_modulacion, ticks_periodo):
+    t0, t1, t2 = get_time_vector(2 * ticks_periodo, indice_modulacion / 100, angulo_grados)
+    return t0 / 2, t1, t2
+
+
+# El punto fijo se compara a la escala del firmware y la regresion a la suya (256 ticks): cada
+# uno contra la referencia de su propio periodo
+def comparar(ticks_periodo=TICKS_MEDIO_PERIODO):
+    error_fijo = []
+    error_regresion = []
+    for indice in range(1, 101):
+        ganancia = ganancia_fija(indice, ticks_periodo)
+        for angulo_sector in range(0, ANGULO_SECTOR, 64):
+            angulo_grados = 60 * angulo_sector / ANGULO_SECTOR
+            ref = np.array(tiempos_referencia(angulo_grados, indice, ticks_periodo))
+            error_fijo.append(np.array(tiempos_fijo(angulo_sector, ganancia, ticks_periodo)) - ref)
+            ref = np.array(tiempos_referencia(angulo_grados, indice, TICKS_PERIODO_REGRESION))
+            error_regresion.append(np.array(tiempos_regresion(angulo_grados, indice)) - ref)
+
+    error_fijo = np.abs(np.array(error_fijo))
+    error_regresion = np.abs(np.array(error_regresion))
+
+    print("Error contra get_time_vector [ticks]     t0      t1      t2")
+    print("  Punto fijo a %d ticks de medio periodo, regresion a %d" % (ticks_periodo, TICKS_PERIODO_REGRESION))
+    print("  Punto fijo, maximo               %7.3f %7.3f %7.3f" % tuple(error_fijo.max(axis=0)))
+    print("  Punto fijo, RMS                  %7.3f %7.3f %7.3f" % tuple(np.sqrt((error_fijo ** 2).mean(axis=0))))
+    print("  Regresion lineal, maximo         %7.3f %7.3f %7.3f" % tuple(error_regresion.max(axis=0)))
+    print("  Regresion lineal, RMS            %7.3f %7.3f %7.3f" % tuple(np.sqrt((error_regresion ** 2).mean(axis=0))))
+
+    # Error de la tabla interpolada frente al seno exacto
+    angulos = np.arange(0, ANGULO_SECTOR + 1)
+    seno = np.array([seno_fijo(a) for a in angulos])
+    exacto = SENO_ESCALA * np.sin(np.radians(60 * angulos / ANGULO_SECTOR))
+    print("Error maximo del seno interpolado: %.2f LSB (Q15)" % np.abs(seno - exacto).max())
+
+
+# Indices bajos (pocos Hz): t1/t2 son pocas decenas de ticks. Error de t1 respecto del
+# valor exacto, promediado en una ventana de muestras (lo que filtra la inductancia
+# del motor) y sin promediar, con redondeo y con el sigma-delta de orden 1 y 2.
+def comparar_sigma_delta(ticks_periodo=TICKS_MEDIO_PERIODO, muestras_por_vuelta=2511, ventana=16):
+    print("Error de t1 [ticks], %d ticks de medio periodo, promedio de %d muestras" % (ticks_periodo, ventana))
+    print("  indice   t1 max   redondeo   orden 1   orden 2   (por muestra: red / o1 / o2)")
+    for indice in (1, 2, 5, 10):
+        ganancia = ganancia_fija(indice, ticks_periodo)
+        exacto = []
+        obtenido = {0: [], 1: [], 2: []}
+        resto = {1: [[0, 0], [0, 0]], 2: [[0, 0], [0, 0]]}
+        for m in range(muestras_por_vuelta):
+            fase = (m * 6 * ANGULO_SECTOR // muestras_por_vuelta) % ANGULO_SECTOR
+            exacto.append(ganancia * seno_fijo(ANGULO_SECTOR - fase) / 2 ** 31)
+            for orden in (0, 1, 2):
+                t0, t1, t2 = tiempos_fijo(fase, ganancia, ticks_periodo, resto=resto.get(orden), orden=orden)
+                obtenido[orden].append(t1)
+        exacto = np.array(exacto)
+        filtro = np.ones(ventana) / ventana
+        fila = []
+        for orden in (0, 1, 2):
+            error = np.array(obtenido[orden]) - exacto
+            fila.append(np.sqrt(np.mean(np.convolve(error, filtro, "valid") ** 2)))
+        muestra = [np.sqrt(np.mean((np.array(obtenido[o]) - exacto) ** 2)) for o in (0, 1, 2)]
+        print("  %6d  %7.1f   %8.3f  %8.3f  %8.3f   (%.2f / %.2f / %.2f)" % ((indice, exacto.max()) + tuple(fila) + tuple(muestra)))
+
+
+if __name__ == "__main__":
+    imprimir_tabla_c()
+    comparar()
+    comparar_sigma_delta()
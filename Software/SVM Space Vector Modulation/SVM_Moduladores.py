@@ -0,0 +1,140 @@
+import numpy as np
+
+from SVM_CalculoPuntoFijo import ANGULO_SECTOR, cuantizar, ganancia_fija, seno_fijo, tiempos_fijo
+
+# Comparacion de los moduladores del firmware (ModuladorSVM.c): SVPWM, SPWM
+# seno-triangulo y THIPWM (tercera armonica de 1/6). Modelo entero de cada uno
+# y, por indice de modulacion:
+#   - Fundamental de la tension de linea U-V [p.u. de Vdc]
+#   - THD de baja frecuencia (tension media por periodo, armonicas 2..40): la
+#     distorsion que agrega el modulador (recorte de SPWM por encima de 90)
+#   - WTHD de la tension de linea con los pulsos reales (serie de Fourier de cada
+#     pulso, hasta 4 veces la portadora): sum((Vh / h)^2), proporcional al ripple
+#     de corriente en una carga inductiva
+# Al final, el costo por muestra en operaciones del Cortex-M3 de cada modulador.
+
+FASE_VUELTA = 1 << 32
+FASE_120_GRADOS = 1431655765
+INV_RAIZ3_Q16 = 37837
+UN_SEXTO_Q15 = 5461
+
+# Medio periodo a 2511 Hz y 50 muestras por ciclo de salida (50 Hz)
+TICKS_PERIODO = 14336
+MUESTRAS_POR_CICLO = 50
+
+# Igual a SVM_SECUENCIA_SECTORES: fase que enciende en ticksC1/C2/C3 por sector
+FASE_CONMUTA = [[0, 1, 2], [1, 0, 2], [1, 2, 0], [2, 1, 0], [2, 0, 1], [0, 2, 1]]
+
+# Operaciones por muestra en ModuladorSVM.c: senos de tabla interpolados,
+# multiplicaciones 32x32->64 y comparaciones de ordenamiento
+COSTO = {
+    "SVPWM": (2, 3, 0),
+    "SPWM": (3, 4, 3),
+    "THIPWM": (4, 5, 3),
+}
+
+
+# Igual a CalculoSVM_Coseno
+def coseno_fijo(fase):
+    fase = (fase + (1 << 30)) % FASE_VUELTA
+    angulo = ((fase & ((1 << 30) - 1)) * 3) >> 15
+    if fase & (1 << 30):
+        angulo = 3 * ANGULO_SECTOR // 2 - angulo
+    seno = seno_fijo(angulo)
+    return -seno if fase & (1 << 31) else seno
+
+
+def sector_de(fase):
+    return (fase * 6) >> 32
+
+
+# Igual a ModuladorSVM_SVPWM
+def svpwm(fase, ganancia, ticks, resto):
+    sector = sector_de(fase)
+    angulo = ((fase * 6) % FASE_VUELTA) >> 16
+    if sector & 1:
+        angulo = ANGULO_SECTOR - angulo
+    t0, t1, t2 = tiempos_fijo(angulo, ganancia, ticks, resto=resto)
+    return sector, [t0, t0 + t1, t0 + t1 + t2]
+
+
+# Igual a ModuladorSVM_Ordenar
+def ordenar(posicion, ticks, resto):
+    p0, p1, p2 = sorted(posicion)
+    t1 = cuantizar(p1 - p0, resto[0])
+    t2 = cuantizar(p2 - p1, resto[1])
+    c0 = (p0 + (1 << 30)) >> 31
+    return [min(c0, ticks), min(c0 + t1, ticks), min(c0 + t1 + t2, ticks)]
+
+
+def posicion(amplitud, v, ticks):
+    return min(max((ticks << 30) - amplitud * v, 0), ticks << 31)
+
+
+# Igual a ModuladorSVM_SPWM / ModuladorSVM_THIPWM
+def spwm(fase, ganancia, ticks, resto, tercera_armonica=False):
+    amplitud = (ganancia * INV_RAIZ3_Q16) >> 16
+    tercera = -((coseno_fijo((fase * 3) % FASE_VUELTA) * UN_SEXTO_Q15) >> 15) if tercera_armonica else 0
+    fases = [fase, (fase - FASE_120_GRADOS) % FASE_VUELTA, (fase + FASE_120_GRADOS) % FASE_VUELTA]
+    return sector_de(fase), ordenar([posicion(amplitud, coseno_fijo(f) + tercera, ticks) for f in fases], ticks, resto)
+
+
+def thipwm(fase, ganancia, ticks, resto):
+    return spwm(fase, ganancia, ticks, resto, tercera_armonica=True)
+
+
+MODULADORES = {"SVPWM": svpwm, "SPWM": spwm, "THIPWM": thipwm}
+
+
+# CCR de cada fase {U, V, W} durante un ciclo de salida
+def ccr_por_fase(modulador, indice, ticks=TICKS_PERIODO, n=MUESTRAS_POR_CICLO):
+    ganancia = ganancia_fija(indice, ticks)
+    resto = [[0, 0], [0, 0]]
+    ccr = np.zeros((n, 3))
+    for m in range(n):
+        sector, flancos = modulador(m * FASE_VUELTA // n, ganancia, ticks, resto)
+        for k in range(3):
+            ccr[m, FASE_CONMUTA[sector][k]] = flancos[k]
+    return ccr
+
+
+def medir(ccr, ticks=TICKS_PERIODO):
+    n = len(ccr)
+    # Media por periodo: la pierna esta en alto mientras CNT >= CCR
+    linea = (ccr[:, 1] - ccr[:, 0]) / ticks
+    espectro = np.abs(np.fft.rfft(linea)) * 2 / n
+    thd = np.sqrt(np.sum(espectro[2:41] ** 2)) / espectro[1]
+
+    # Pulsos reales: periodo 2 * ticks, en alto de ccr a 2 * ticks - ccr
+    periodo = 2 * ticks
+    armonicas = np.arange(1, 4 * n + 1)
+    w = 2 * np.pi * armonicas[:, None] / (n * periodo)
+    inicio = np.arange(n)[None, :] * periodo
+    coef = np.zeros(len(armonicas), dtype=complex)
+    for fase, signo in ((0, 1), (1, -1)):
+        subida = inicio + ccr[None, :, fase]
+        bajada = inicio + periodo - ccr[None, :, fase]
+        coef += signo * np.sum(np.exp(-1j * w * subida) - np.exp(-1j * w * bajada), axis=1) / (1j * w[:, 0])
+    amplitud = np.abs(coef) * 2 / (n * periodo)
+    wthd = np.sqrt(np.sum((amplitud[1:] / armonicas[1:]) ** 2)) / amplitud[0]
+    return amplitud[0], thd, wthd
+
+
+def comparar():
+    print("Moduladores, %d ticks de medio periodo, %d muestras por ciclo" % (TICKS_PERIODO, MUESTRAS_POR_CICLO))
+    print("  indice  " + "".join("%-28s" % nombre for nombre in MODULADORES))
+    print("          " + "V1 [pu]  THD [%] WTHD [%]   " * len(MODULADORES))
+    for indice in (20, 40, 60, 80, 90, 95, 100, 104):
+        fila = "  %6d  " % indice
+        for modulador in MODULADORES.values():
+            v1, thd, wthd = medir(ccr_por_fase(modulador, indice))
+            fila += "%7.4f  %7.2f  %7.3f    " % (v1, 100 * thd, 100 * wthd)
+        print(fila)
+
+    print("Costo por muestra          senos  mult 64b  comparaciones")
+    for nombre, (senos, multiplicaciones, comparaciones) in COSTO.items():
+        print("  %-24s %5d  %8d  %13d" % (nombre, senos, multiplicaciones, comparaciones))
+
+
+if __name__ == "__main__":
+    comparar()
@@ -0,0 +1,118 @@
+import numpy as np
+
+from SVM_CalculoPuntoFijo import ANGULO_SECTOR, TICKS_PERIODO, ganancia_fija, tiempos_fijo
+
+# Sobremodulacion del firmware (CalculoSVM.c): genera la tabla tablaSobremodulacion
+# y verifica con el modelo entero la fundamental que se obtiene en cada indice.
+#
+# Unidades: el indice de modulacion es proporcional a la fundamental de la tension
+# de salida, con 100 = ganancia (3/pi) * ticks del modo lineal.
+#   - Lineal: hasta pi/3 * 100 = 104.7 (circulo inscripto en el hexagono)
+#   - Modo I: la referencia se agranda y lo que sale del hexagono se proyecta
+#     sobre su lado. Termina cuando toda la trayectoria es el hexagono (109.9).
+#   - Modo II: el vector se retiene en el vertice durante el angulo de retencion y
+#     recorre el lado en el resto del sector. Con 30 grados es seis pasos (115.5).
+
+INDICE_LINEAL = 104
+INDICE_SEIS_PASOS = 116
+
+# Ganancia relativa (ganancia / ticks) en Q16 con la que todo el circulo queda
+# fuera del hexagono: 2 / sqrt(3). En el modo II se usa el doble para asegurarlo
+# con el redondeo.
+GANANCIA_HEXAGONO = 2 / np.sqrt(3)
+GANANCIA_MODO_II = 2.0
+
+ANGULOS = np.linspace(0, np.pi / 3, 4001)
+
+
+def fundamental(t1, t2):
+    # Vector de salida en el sector (vertices V1 = 1, V2 = e^(j60)) proyectado
+    # sobre el angulo de referencia. Promedio en el sector = fundamental.
+    v = (t1 + t2 * np.exp(1j * np.pi / 3)) / TICKS_PERIODO
+    return np.mean(np.real(v * np.exp(-1j * ANGULOS)))
+
+
+def trayectoria(ganancia_relativa, retencion):
+    theta = ANGULOS.copy()
+    if retencion > 0:
+        medio = (theta - retencion) * (np.pi / 3) / max(np.pi / 3 - 2 * retencion, 1e-12)
+        theta = np.where(theta <= retencion, 0, np.where(theta >= np.pi / 3 - retencion, np.pi / 3, medio))
+    t1 = ganancia_relativa * TICKS_PERIODO * np.sin(np.pi / 3 - theta)
+    t2 = ganancia_relativa * TICKS_PERIODO * np.sin(theta)
+    suma = t1 + t2
+    fuera = suma > TICKS_PERIODO
+    t1 = np.where(fuera, t1 * TICKS_PERIODO / suma, t1)
+    t2 = np.where(fuera, TICKS_PERIODO - t1, t2)
+    return t1, t2
+
+
+# Fundamental del indice 100, referencia de la escala
+REFERENCIA = fundamental(*trayectoria(3 / np.pi, 0))
+
+
+def indice(ganancia_relativa, retencion):
+    return 100 * fundamental(*trayectoria(ganancia_relativa, retencion)) / REFERENCIA
+
+
+def biseccion(f, a, b, objetivo):
+    for _ in range(60):
+        m = (a + b) / 2
+        if f(m) < objetivo:
+            a = m
+        else:
+            b = m
+    return (a + b) / 2
+
+
+def generar_tabla():
+    tabla = []
+    limite_modo_I = indice(GANANCIA_HEXAGONO, 0)
+    for objetivo in range(INDICE_LINEAL + 1, INDICE_SEIS_PASOS + 1):
+        if objetivo <= limite_modo_I:
+            g = biseccion(lambda x: indice(x, 0), 1.0, GANANCIA_HEXAGONO, objetivo)
+            tabla.append((objetivo, int(round(g * 65536)), 0, 0))
+        else:
+            r = biseccion(lambda x: indice(GANANCIA_MODO_II, x), 0, np.pi / 6, objetivo)
+            retencion = int(round(r / (np.pi / 3) * ANGULO_SECTOR))
+            retencion = min(retencion, ANGULO_SECTOR // 2)
+            escala = 0 if retencion == ANGULO_SECTOR // 2 else (ANGULO_SECTOR << 16) // (ANGULO_SECTOR - 2 * retencion)
+            tabla.append((objetivo, int(GANANCIA_MODO_II * 65536), retencion, escala))
+    return tabla
+
+
+def imprimir_tabla_c(tabla):
+    print("static const EntradaSobremodulacion tablaSobremodulacion[CALCULO_SVM_INDICE_SEIS_PASOS - CALCULO_SVM_INDICE_LINEAL] = {")
+    for objetivo, g, r, e in tabla:
+        print("    { %6d, %5d, %7d },   /* %d */" % (g, r, e, objetivo))
+    print("};")
+
+
+# Fundamental del modelo entero (bit a bit con el firmware) sobre un sector
+def indice_fijo(g, r, e):
+    ganancia = TICKS_PERIODO * g
+    t1 = []
+    t2 = []
+    for a in np.round(ANGULOS / (np.pi / 3) * ANGULO_SECTOR).astype(int):
+        _, x1, x2 = tiempos_fijo(int(a), ganancia, TICKS_PERIODO, r, e)
+        t1.append(x1)
+        t2.append(x2)
+    return 100 * fundamental(np.array(t1), np.array(t2)) / REFERENCIA
+
+
+def verificar(tabla):
+    print("Indice  Modo   Ganancia  Retencion[grados]  Fundamental (modelo entero)")
+    for i in (100, INDICE_LINEAL):
+        g = ganancia_fija(i, TICKS_PERIODO)
+        t = [tiempos_fijo(int(a), g, TICKS_PERIODO) for a in np.round(ANGULOS / (np.pi / 3) * ANGULO_SECTOR).astype(int)]
+        t1 = np.array([x[1] for x in t])
+        t2 = np.array([x[2] for x in t])
+        print("%6d  lineal %8.4f  %17.2f  %8.2f" % (i, g / 65536 / TICKS_PERIODO, 0, 100 * fundamental(t1, t2) / REFERENCIA))
+    for objetivo, g, r, e in tabla:
+        modo = "I" if r == 0 else ("6 pasos" if r == ANGULO_SECTOR // 2 else "II")
+        print("%6d  %-6s %8.4f  %17.2f  %8.2f" % (objetivo, modo, g / 65536, r * 60 / ANGULO_SECTOR, indice_fijo(g, r, e)))
+
+
+if __name__ == "__main__":
+    tabla = generar_tabla()
+    imprimir_tabla_c(tabla)
+    verificar(tabla)
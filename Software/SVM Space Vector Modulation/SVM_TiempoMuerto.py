@@ -0,0 +1,132 @@
+import numpy as np
+
+from SVM_CalculoPuntoFijo import ANGULO_SECTOR, ganancia_fija, tiempos_fijo
+
+# Compensacion de tiempo muerto del firmware (GestorSVM_CompensarTiempoMuerto).
+# Simula, periodo a periodo de switching, el ancho en alto de cada pierna con el
+# tiempo muerto real de los drivers y compara la tension de linea U-V media por
+# periodo con la ideal: error de la fundamental y THD, de 1 a 10 Hz.
+#
+# Modelo del tiempo muerto: con corriente saliente el encendido se atrasa Td y la
+# pierna pierde Td de alto por periodo; con corriente entrante lo gana. El
+# firmware no mide corriente: estima su signo con la fase de referencia atrasada
+# DESFASE_ESTIMADO. La carga real se modela como una corriente senoidal atrasada
+# DESFASE_CARGA respecto de la tension.
+
+# Timer de switching sin prescaler: ARR = 72 MHz / (2 * FREC_SWITCH)
+FREC_TIMER = 72000000
+FREC_SWITCH = 2511
+MAX_TICKS = (FREC_TIMER // 2 + FREC_SWITCH // 2) // FREC_SWITCH
+TICKS_PERIODO = MAX_TICKS - 1
+FASE_VUELTA = 1 << 32
+FASE_30_GRADOS = 357913941
+
+# IR2104 de la placa: 520 ns = 37.44 ticks de 1 / 72 MHz (Q8). TIM1: DTG = 72 -> 1 us
+TIEMPO_MUERTO_IR2104_Q8 = 9585
+TIEMPO_MUERTO_TIM1_Q8 = 72 * 256
+
+DESFASE_ESTIMADO = 30
+DESFASE_CARGA = 30
+
+# Igual a SVM_SECUENCIA_SECTORES (primera mitad del periodo)
+SECUENCIA = [
+    [0b000, 0b100, 0b110, 0b111],
+    [0b000, 0b010, 0b110, 0b111],
+    [0b000, 0b010, 0b011, 0b111],
+    [0b000, 0b001, 0b011, 0b111],
+    [0b000, 0b001, 0b101, 0b111],
+    [0b000, 0b100, 0b101, 0b111],
+]
+BIT_A_FASE = {0b100: 0, 0b010: 1, 0b001: 2}
+FASE_CONMUTA = [[BIT_A_FASE[s[k] ^ s[k + 1]] for k in range(3)] for s in SECUENCIA]
+
+# Igual a corrienteSalientePorRegion
+CORRIENTE_SALIENTE = [0b100, 0b110, 0b010, 0b011, 0b001, 0b101]
+
+
+def grados_a_fase(grados):
+    return grados * (FASE_30_GRADOS // 30)
+
+
+def compensar(ticks, fase, cuadrante, resto, tiempo_muerto_q8, desfase):
+    resto += tiempo_muerto_q8 >> 1
+    compensacion = resto >> 8
+    resto &= 0xFF
+    if compensacion == 0:
+        return ticks, resto
+
+    region = (((fase - desfase + FASE_30_GRADOS) % FASE_VUELTA) * 6) >> 32
+    saliente = CORRIENTE_SALIENTE[region]
+    for k in range(3):
+        if saliente & (0b100 >> FASE_CONMUTA[cuadrante][k]):
+            ticks[k] -= compensacion
+        else:
+            ticks[k] += compensacion
+
+    ticks[0] = max(ticks[0], 0)
+    ticks[2] = min(ticks[2], TICKS_PERIODO)
+    ticks[1] = min(max(ticks[1], ticks[0]), ticks[2])
+    ticks[0] = min(ticks[0], ticks[1])
+    return ticks, resto
+
+
+def simular(frec, tiempo_muerto_q8, compensado, desfase_carga=DESFASE_CARGA, desfase_estimado=DESFASE_ESTIMADO):
+    # Ley V/f del firmware: indice = f / 0.5 Hz
+    indice = min(max(int(frec * 2), 1), 104)
+    ganancia = ganancia_fija(indice, TICKS_PERIODO)
+    n = int(round(FREC_SWITCH / frec))
+    incremento = FASE_VUELTA // n
+    tiempo_muerto = tiempo_muerto_q8 / 256
+    desfase = grados_a_fase(desfase_estimado)
+
+    fase = 0
+    resto = 0
+    tension = np.zeros((n, 3))
+    for m in range(n):
+        fase = (fase + incremento) % FASE_VUELTA
+        fase_sector = fase * 6
+        cuadrante = fase_sector >> 32
+        angulo = (fase_sector % FASE_VUELTA) >> 16
+        if cuadrante & 1:
+            angulo = ANGULO_SECTOR - angulo
+
+        t0, t1, t2 = tiempos_fijo(angulo, ganancia, TICKS_PERIODO)
+        ticks = [t0, t0 + t1, t0 + t1 + t2]
+        if compensado:
+            ticks, resto = compensar(ticks, fase, cuadrante, resto, tiempo_muerto_q8, desfase)
+
+        theta = 2 * np.pi * fase / FASE_VUELTA
+        for k in range(3):
+            f = FASE_CONMUTA[cuadrante][k]
+            ancho = 2 * (MAX_TICKS - ticks[k])
+            corriente = np.cos(theta - np.radians(desfase_carga) - 2 * np.pi / 3 * f)
+            tension[m, f] = (ancho - tiempo_muerto * np.sign(corriente)) / (2 * MAX_TICKS)
+
+    linea = tension[:, 0] - tension[:, 1]
+    espectro = np.abs(np.fft.rfft(linea)) * 2 / n
+    fundamental = espectro[1]
+    thd = np.sqrt(np.sum(espectro[2:41] ** 2)) / fundamental
+    return fundamental, thd
+
+
+def tabla(titulo, tiempo_muerto_q8, **kwargs):
+    print(titulo)
+    print("  f [Hz]  indice   error V1 [%]          THD [%]")
+    print("                   sin comp  con comp    sin comp  con comp")
+    for frec in range(1, 11):
+        ideal, _ = simular(frec, 0, False)
+        sin_comp, thd_sin = simular(frec, tiempo_muerto_q8, False, **kwargs)
+        con_comp, thd_con = simular(frec, tiempo_muerto_q8, True, **kwargs)
+        print("  %6d  %6d  %8.2f  %8.2f    %8.2f  %8.2f" % (
+            frec, min(frec * 2, 104),
+            100 * (sin_comp - ideal) / ideal, 100 * (con_comp - ideal) / ideal,
+            100 * thd_sin, 100 * thd_con))
+
+
+if __name__ == "__main__":
+    tabla("IR2104, Td = %.2f ticks, desfase de carga %d grados" % (TIEMPO_MUERTO_IR2104_Q8 / 256, DESFASE_CARGA),
+          TIEMPO_MUERTO_IR2104_Q8)
+    tabla("TIM1, Td = %.2f ticks, desfase de carga %d grados" % (TIEMPO_MUERTO_TIM1_Q8 / 256, DESFASE_CARGA),
+          TIEMPO_MUERTO_TIM1_Q8)
+    tabla("IR2104, desfase de carga 60 grados (estimado %d)" % DESFASE_ESTIMADO,
+          TIEMPO_MUERTO_IR2104_Q8, desfase_carga=60)
@@ -50,21 +50,35 @@ SPI_Response SPI_SendRequest(SPI_Request request, int setValue, int* getValue) {
     uint8_t rx_buffer[4];
     esp_err_t ret;
     int flagDevolverValor;      // Se necesita devolver el valor por parametro
+    int flagValor16Bits;        // El valor viaja en 16 bits, byte alto primero
 
     printf("[SPI Module] Request %d\n", request);
 
-    // Chequeo de errores fuera de rango y comando desconocido
-    if(setValue > 512 || setValue < 0) {
-        return SPI_RESPONSE_ERR_DATA_INVALID;
-    }
-
     if(request < SPI_REQUEST_START || request >= SPI_REQUEST_LAST) {
         printf("[SPI Module] Comando desconocido\n");
         return SPI_RESPONSE_ERR_CMD_UNKNOWN;
     }
 
+    // Frecuencias (centesimas de Hz y Hz de switching), tension del bus (V) y perfil (camino << 8 | campo) en 16 bits,
+    // el resto en un byte
+    if(request == SPI_REQUEST_SET_FREC || request == SPI_REQUEST_GET_FREC ||
+       request == SPI_REQUEST_SET_FREC_SWITCH || request == SPI_REQUEST_GET_FREC_SWITCH ||
+       request == SPI_REQUEST_SET_VBUS || request == SPI_REQUEST_GET_VBUS ||
+       request == SPI_REQUEST_GET_PERFIL) {
+        flagValor16Bits = 1;
+    }else {
+        flagValor16Bits = 0;
+    }
+
+    // Chequeo de errores fuera de rango
+    if(setValue < 0 || setValue > (flagValor16Bits ? 0xFFFF : 0xFF)) {
+        return SPI_RESPONSE_ERR_DATA_INVALID;
+    }
+
     // Es de los comandos que deben devolver un valor por parametro?
-    if(request >= SPI_REQUEST_GET_FREC && request <= SPI_REQUEST_IS_STOP) {
+    if((request >= SPI_REQUEST_GET_FREC && request <= SPI_REQUEST_IS_STOP) ||
+       request == SPI_REQUEST_GET_FREC_SWITCH || request == SPI_REQUEST_GET_MODULADOR ||
+       request == SPI_REQUEST_GET_VBUS || request == SPI_REQUEST_GET_PERFIL) {
         flagDevolverValor = 1;
     }else {
         flagDevolverValor = 0;
@@ -73,9 +87,9 @@ SPI_Response SPI_SendRequest(SPI_Request request, int setValue, int* getValue) {
     // Se arma la cadena a enviar
     tx_buffer[0] = request;
 
-    if(setValue > 255) {
-        tx_buffer[1] = 255;
-        tx_buffer[2] = setValue - 255;
+    if(flagValor16Bits) {
+        tx_buffer[1] = (uint8_t)(setValue >> 8);
+        tx_buffer[2] = (uint8_t)setValue;
         tx_buffer[3] = ';';
     }else {
         tx_buffer[1] = setValue;
@@ -121,7 +135,11 @@ SPI_Response SPI_SendRequest(SPI_Request request, int setValue, int* getValue) {
 
     if(flagDevolverValor && rx_buffer[0] == SPI_RESPONSE_OK) {
         
-        *getValue = rx_buffer[1] + rx_buffer[2];
+        if(flagValor16Bits) {
+            *getValue = (rx_buffer[1] << 8) | rx_buffer[2];
+        }else {
+            *getValue = rx_buffer[1];
+        }
         printf("RxValores: %d - %d", rx_buffer[1], rx_buffer[2]);
         
     }else {
@@ -24,7 +24,15 @@ typedef enum {
     SPI_REQUEST_GET_DIR     = 19,
     SPI_REQUEST_IS_STOP     = 20,
     SPI_REQUEST_EMERGENCY   = 21,
-    SPI_REQUEST_LAST        = 22,
+    SPI_REQUEST_SET_FREC_SWITCH = 22,
+    SPI_REQUEST_GET_FREC_SWITCH = 23,
+    SPI_REQUEST_SET_MODULADOR   = 24,
+    SPI_REQUEST_GET_MODULADOR   = 25,
+    SPI_REQUEST_SET_VBUS    = 26,
+    SPI_REQUEST_GET_VBUS    = 27,
+    SPI_REQUEST_RESET_PERFIL    = 28,
+    SPI_REQUEST_GET_PERFIL      = 29,
+    SPI_REQUEST_LAST        = 30,
 } SPI_Request;
 
 typedef enum {
@@ -59,8 +67,8 @@ void SPI_Init(void);
  *
  * @param request En este se carga el tipo de consulta que se requiere
  * @param setValue Dependiendo del tipo de request se necesita un valor o no. Si es un setFrec
- * le debemo enviar en este campo la frecuencia deseada. Si se quiere retornar un valor es 
- * indistinto el valor que se ingrese a este campo. 
+ * le debemo enviar en este campo la frecuencia deseada en centesimas de Hz (5012 = 50.12 Hz).
+ * Si se quiere retornar un valor es indistinto el valor que se ingrese a este campo. 
  * @param getValue Este campo se utiliza para retornar un valor en caso que coresponda, manejar
  * los punteros respectivamente, el programa espera espacio para un solo int en el que se guardara
  * informacion de retorno aparte de la respuesta return de la funcion.